@@ -2,26 +2,21 @@
 // Hypothetical optimization algorithm, with optional arguments:
 // - absolute_precision,relative_precision
 // - maximum_iterations
-// - lower_bounds, upper_bounds
+// - lower_bounds, upper_bounds, a scalar (broadcasted) or a vector
+// - workspace, scratch memory reused across calls
 //
 
-#include "OptionalArgument/optional_argument.hpp"
-
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <optional>
+#include <stdexcept>
 #include <vector>
 
-namespace OptionalArgument
-{
-  template <typename T>
-  std::ostream&
-  operator<<(std::ostream& out, const std::vector<T>& to_print)
-  {
-    for (const auto& to_print_i : to_print) out << to_print_i << " ";
-    return out;
-  }
-}  // namespace OptionalArgument
+#include "OptionalArgument/named_broadcast_vector.hpp"
+#include "OptionalArgument/optional_argument.hpp"
+#include "OptionalArgument/option_validation.hpp"
+#include "OptionalArgument/workspace.hpp"
 
 using namespace OptionalArgument;
 
@@ -35,15 +30,29 @@ using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
 constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
 
 template <typename T>
-using Lower_Bounds = Named_Type<struct Lower_Bounds_Tag, std::vector<T>>;
+using Lower_Bounds = Named_Broadcast_Vector<struct Lower_Bounds_Tag, T>;
 template <typename T>
 constexpr auto lower_bounds = typename Lower_Bounds<T>::argument_syntactic_sugar();
 
 template <typename T>
-using Upper_Bounds = Named_Type<struct Upper_Bounds_Tag, std::vector<T>>;
+using Upper_Bounds = Named_Broadcast_Vector<struct Upper_Bounds_Tag, T>;
 template <typename T>
 constexpr auto upper_bounds = typename Upper_Bounds<T>::argument_syntactic_sugar();
 
+template <typename T>
+using Optimization_Workspace = Named_Workspace<struct Optimization_Workspace_Tag, T>;
+template <typename T>
+constexpr auto workspace = typename Optimization_Workspace<T>::argument_syntactic_sugar();
+
+// Scratch memory needed by optimization_algorithm()
+//
+template <typename T>
+std::size_t
+optimization_algorithm_workspace_size(const std::size_t n)
+{
+  return Workspace<T>::required_size(n, n);
+}
+
 template <typename T, typename... USER_OPTIONS>
 void
 optimization_algorithm(std::vector<T>& x, USER_OPTIONS&&... user_options)
@@ -53,14 +62,47 @@ optimization_algorithm(std::vector<T>& x, USER_OPTIONS&&... user_options)
   Relative_Precision relative_precision{1e-10};
   std::optional<Lower_Bounds<T>> lower_bound;
   std::optional<Upper_Bounds<T>> upper_bound;
+  Optimization_Workspace<T> workspace;  // internal temporary if omitted
 
   auto options = take_optional_argument_ref(max_iterations, absolute_precision, relative_precision,
-                                            lower_bound, upper_bound);
+                                            lower_bound, upper_bound, workspace);
   optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
 
+  // cross-option checks, once per call
+  check_option_constraints(options, option_constraint<Lower_Bounds<T>, Upper_Bounds<T>>(
+                                        Elementwise_Less_Equal(), "lower_bounds <= upper_bounds"));
+
   std::cerr << "Option values: " << options << std::endl;
 
   // implementation ...
+  const std::size_t n = x.size();
+
+  // a vector bound must have the size of x
+  if ((lower_bound && not lower_bound->is_compatible_size(n)) ||
+      (upper_bound && not upper_bound->is_compatible_size(n)))
+  {
+    throw std::domain_error("bounds and x sizes differ");
+  }
+
+  // same code for scalar and vector bounds
+  if (lower_bound)
+  {
+    const auto lb = lower_bound->view();
+    for (std::size_t i = 0; i < n; ++i) x[i] = std::max(x[i], lb[i]);
+  }
+  if (upper_bound)
+  {
+    const auto ub = upper_bound->view();
+    for (std::size_t i = 0; i < n; ++i) x[i] = std::min(x[i], ub[i]);
+  }
+
+  auto [gradient, direction] = workspace.value().acquire(n, n);
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    gradient[i]  = 2 * x[i];
+    direction[i] = -gradient[i];
+  }
 }
 
 int
@@ -69,15 +111,34 @@ main()
   const size_t n = 4;
   std::vector<double> x_init(n);
 
-  // Option values: 100 1e-10 1e-10
+  // Option values: 100 1e-10 1e-10 temporary workspace(0)
   optimization_algorithm(x_init);
 
-  // Option values: 50 1e-10 1e-10 0 0 0 0
-  optimization_algorithm(x_init, max_iterations = 50,
-                         lower_bounds<double> = std::vector<double>(n, 0));
+  // Option values: 50 1e-10 1e-10 0 (broadcast) temporary workspace(0)
+  //
+  // no n-element vector of zeros
+  optimization_algorithm(x_init, max_iterations = 50, lower_bounds<double> = 0);
 
-  // Option values: 50 1e-08 1e-10 0 0 0 0  1 1 1 1
+  // Option values: 50 1e-08 1e-10 0 0 0 0  1 1 1 1  temporary workspace(0)
   optimization_algorithm(x_init, max_iterations = 50, absolute_precision = 1e-8,
                          lower_bounds<double> = std::vector<double>(n, 0),
                          upper_bounds<double> = std::vector<double>(n, 1));
+
+  // Option values: 100 1e-10 1e-10 workspace(8)
+  //
+  // allocated once, reused by the next calls
+  Workspace<double> scratch(optimization_algorithm_workspace_size<double>(n));
+  for (size_t i = 0; i < 3; ++i) optimization_algorithm(x_init, workspace<double> = scratch);
+
+  std::cerr << "Workspace allocations: " << scratch.grow_count() << std::endl;
+
+  // a vector bound of the wrong size is rejected
+  try
+  {
+    optimization_algorithm(x_init, lower_bounds<double> = {0, 0});
+  }
+  catch (const std::domain_error& e)
+  {
+    std::cerr << "Error: " << e.what() << std::endl;
+  }
 }
@@ -0,0 +1,116 @@
+#!/bin/sh
+# Compile time of a translation unit defining one algorithm with
+# optional arguments, depending on what it includes:
+#
+#   core      optional_argument_core.hpp
+#   iostream  optional_argument_core.hpp + optional_argument_iostream.hpp
+#   full      optional_argument.hpp
+#   module    import OptionalArgument;   (C++20, module built once)
+#
+# usage: examples/compile_time_benchmark.sh [compiler] [repetitions]
+#
+# For GCC the module variant needs GCC >= 14 (GCC 12 builds the module
+# interface but crashes when importing it).
+#
+CXX=${1:-${CXX:-g++}}
+REPETITIONS=${2:-10}
+
+SRC_DIR=$(cd "$(dirname "$0")/../src" && pwd)
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+body()
+{
+  cat <<'EOF'
+
+using namespace OptionalArgument;
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Absolute_Precision          = Named_Type<struct Absolute_Precision_Tag, double>;
+constexpr auto absolute_precision = typename Absolute_Precision::argument_syntactic_sugar();
+
+using Use_Line_Search          = Named_Type<struct Use_Line_Search_Tag>;
+constexpr auto use_line_search = Use_Line_Search();
+
+template <typename... USER_OPTIONS>
+double
+algorithm(double x, USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{100};
+  Absolute_Precision absolute_precision{1e-6};
+  std::optional<Use_Line_Search> use_line_search;
+
+  auto options = take_optional_argument_ref(max_iterations, absolute_precision, use_line_search);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  return x * max_iterations.value() + absolute_precision.value() + use_line_search.has_value();
+}
+
+double
+run(double x)
+{
+  return algorithm(x, max_iterations = 10, use_line_search) + algorithm(x);
+}
+EOF
+}
+
+{ echo '#include "OptionalArgument/optional_argument_core.hpp"'; body; } > "$WORK_DIR/core.cpp"
+{
+  echo '#include "OptionalArgument/optional_argument_core.hpp"'
+  echo '#include "OptionalArgument/optional_argument_iostream.hpp"'
+  body
+} > "$WORK_DIR/iostream.cpp"
+{ echo '#include "OptionalArgument/optional_argument.hpp"'; body; } > "$WORK_DIR/full.cpp"
+{ echo '#include <optional>'; echo '#include <utility>'; echo 'import OptionalArgument;'; body; } \
+  > "$WORK_DIR/module.cpp"
+
+# mean wall time in ms of $REPETITIONS runs of "$@"
+measure()
+{
+  start=$(date +%s%N)
+  i=0
+  while [ $i -lt "$REPETITIONS" ]; do
+    "$@" > /dev/null 2>&1 || return 1
+    i=$((i + 1))
+  done
+  stop=$(date +%s%N)
+  echo $(((stop - start) / 1000000 / REPETITIONS))
+}
+
+cd "$WORK_DIR" || exit 1
+
+for variant in core iostream full; do
+  ms=$(measure "$CXX" -std=c++17 -O2 -I"$SRC_DIR" -c $variant.cpp -o $variant.o)
+  lines=$("$CXX" -std=c++17 -I"$SRC_DIR" -E $variant.cpp | wc -l)
+  printf '%-10s %6s ms %8s preprocessed lines\n' $variant "$ms" "$lines"
+done
+
+MODULE_SOURCE="$SRC_DIR/OptionalArgument/optional_argument.cppm"
+
+case $("$CXX" --version) in
+  *clang*)
+    interface_ms=$(measure "$CXX" -std=c++20 -I"$SRC_DIR" -x c++-module --precompile \
+      "$MODULE_SOURCE" -o OptionalArgument.pcm)
+    module_ms=$(measure "$CXX" -std=c++20 -fmodule-file=OptionalArgument=OptionalArgument.pcm \
+      -O2 -c module.cpp -o module.o)
+    ;;
+  *)
+    interface_ms=$(measure "$CXX" -std=c++20 -fmodules-ts -I"$SRC_DIR" -x c++ -c \
+      "$MODULE_SOURCE" -o optional_argument.o)
+    module_ms=$(measure "$CXX" -std=c++20 -fmodules-ts -O2 -c module.cpp -o module.o)
+    ;;
+esac
+
+report()
+{
+  if [ -n "$2" ]; then
+    printf '%-10s %6s ms %s\n' "$1" "$2" "$3"
+  else
+    printf '%-10s %6s\n' "$1" "failed (needs GCC >= 14 or Clang >= 17)"
+  fi
+}
+
+report interface "$interface_ms" "(module interface, built once)"
+report module "$module_ms"
@@ -1,4 +1,5 @@
 #include "OptionalArgument/optional_argument.hpp"
+#include "OptionalArgument/option_validation.hpp"
 
 #include <cassert>
 
@@ -23,9 +24,33 @@ my_algorithm(const Absolute_Precision& absolute_precision)
 {
 }
 
+// Compile-time checked version: constant values are checked at
+// compile time, run-time values trap (instead of an assert that
+// vanishes with NDEBUG)
+//
+using Relative_Precision =
+    Named_Assert_Type<struct Relative_Precision_Tag,
+                      Assert_Predicate<Is_Positive, Trap_On_Failure>, double>;
+constexpr auto relative_precision = typename Relative_Precision::argument_syntactic_sugar();
+
+void
+my_other_algorithm(const Relative_Precision&)
+{
+}
+
 int
 main()
 {
+  constexpr Relative_Precision default_relative_precision = (relative_precision = 1e-6);
+  // constexpr Relative_Precision wrong = (relative_precision = -1e-6);  // does not compile
+
+  my_other_algorithm(default_relative_precision);
+  my_other_algorithm(relative_precision = +1e-6);  // no run-time check left (optimized build)
+  // run-time failure (trap), does not compile with -DOPTIONAL_ARGUMENT_LITERAL_CHECK=1 (GCC
+  // optimized build):
+  //
+  // my_other_algorithm(relative_precision = -1e-6);
+
   my_algorithm(absolute_precision = +1e-6);
   my_algorithm(absolute_precision = -1e-6);  // run-time assert fail
 }
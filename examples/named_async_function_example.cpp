@@ -0,0 +1,98 @@
+// A random search keeping several slow objective evaluations in
+// flight: the candidates of the next generation are prepared while the
+// current ones are evaluated.
+//
+#include "OptionalArgument/named_async_function.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace OptionalArgument;
+
+using Objective_Function =
+    Named_Async_Function<struct Objective_Function_Tag, double, const std::vector<double>&>;
+constexpr auto objective_function = Argument_Syntactic_Sugar<Objective_Function>();
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Population_Size          = Named_Type<struct Population_Size_Tag, size_t>;
+constexpr auto population_size = typename Population_Size::argument_syntactic_sugar();
+
+// stands for an external simulation
+double
+slow_Rosenbrock(const std::vector<double>& x)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  return (1 - x[0]) * (1 - x[0]) + 10 * (x[1] - x[0] * x[0]) * (x[1] - x[0] * x[0]);
+}
+
+template <typename... USER_OPTIONS>
+std::vector<double>
+random_search(const Objective_Function& f, std::vector<double> x, USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{10};
+  Population_Size population_size{8};
+
+  auto options = take_optional_argument_ref(max_iterations, population_size);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  std::mt19937 engine(0);
+  std::normal_distribution<double> perturbation(0, 0.1);
+
+  auto generate = [&](const std::vector<double>& center) {
+    std::vector<std::vector<double>> candidates(population_size.value(), center);
+    for (auto& candidate : candidates)
+    {
+      for (auto& x_i : candidate) x_i += perturbation(engine);
+    }
+    return candidates;
+  };
+
+  double f_x       = f(x).get();
+  auto candidates  = generate(x);
+  auto evaluations = f.batch(candidates);
+
+  for (size_t iteration = 0; iteration < max_iterations.value(); ++iteration)
+  {
+    // overlaps the evaluations in flight
+    auto next_candidates = generate(x);
+
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+      const double f_candidate = evaluations[i].get();
+      if (f_candidate < f_x)
+      {
+        f_x = f_candidate;
+        x   = candidates[i];
+      }
+    }
+    std::cout << "iteration " << iteration << " f = " << f_x << std::endl;
+
+    candidates  = std::move(next_candidates);
+    evaluations = f.batch(candidates);
+  }
+  for (auto& evaluation : evaluations) evaluation.wait();
+
+  return x;
+}
+
+int
+main()
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  // evaluations are latency bound: more threads than cores
+  const auto executor = std::make_shared<Thread_Pool_Executor>(8);
+
+  random_search((objective_function = slow_Rosenbrock).with_executor(executor), {-1, 1},
+                max_iterations = 20, population_size = 8);
+
+  const auto stop = std::chrono::steady_clock::now();
+  std::cout << "elapsed: " << std::chrono::duration<double>(stop - start).count()
+            << " s (sequential: " << 21 * 8 * 0.02 << " s)" << std::endl;
+}
@@ -0,0 +1,77 @@
+// Compares bulk operations on std::vector<Named_Type<TAG,double>>
+// with the same loops on raw double arrays.
+//
+// Compile with optimizations (-O3 -march=native) to get the vector
+// instructions, both versions must run at the same speed.
+//
+#include "OptionalArgument/named_type_array.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace OptionalArgument;
+
+using Coordinate = Named_Type<struct Coordinate_Tag, double>;
+
+template <typename F>
+double
+time_it(const char* name, const size_t repetitions, F f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < repetitions; ++r) f();
+  const auto stop = std::chrono::steady_clock::now();
+
+  const double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+  std::cout << name << ": " << ms / repetitions << " ms" << std::endl;
+  return ms;
+}
+
+void
+raw_axpy(const double alpha, const double* __restrict__ x, double* __restrict__ y, const size_t n)
+{
+  for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+double
+raw_dot(const double* x, const double* y, const size_t n)
+{
+  const size_t n_4 = n - n % 4;
+
+  double sum[4] = {0, 0, 0, 0};
+  for (size_t i = 0; i < n_4; i += 4)
+  {
+    for (size_t k = 0; k < 4; ++k) sum[k] += x[i + k] * y[i + k];
+  }
+  for (size_t i = n_4; i < n; ++i) sum[0] += x[i] * y[i];
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+int
+main()
+{
+  const size_t n           = 1 << 20;
+  const size_t repetitions = 200;
+
+  std::vector<double> raw_x(n, 1), raw_y(n, 2);
+  std::vector<Coordinate> x(n, Coordinate{1.}), y(n, Coordinate{2.}), z(n, Coordinate{2.});
+
+  time_it("axpy double[]          ", repetitions,
+          [&]() { raw_axpy(1e-6, raw_x.data(), raw_y.data(), n); });
+  time_it("axpy Named_Type array  ", repetitions,
+          [&]() { bulk_axpy(1e-6, make_span(std::as_const(x)), make_span(y)); });
+  // zero copy: hands the named array to a raw kernel
+  time_it("axpy via as_value_span ", repetitions,
+          [&]() { raw_axpy(1e-6, as_value_span(x).data(), as_value_span(z).data(), n); });
+
+  // volatile: the dot products can not be hoisted out of the timing loops
+  volatile double raw_result = 0, named_result = 0;
+
+  time_it("dot  double[]          ", repetitions,
+          [&]() { raw_result = raw_dot(raw_x.data(), raw_y.data(), n); });
+  time_it("dot  Named_Type array  ", repetitions,
+          [&]() { named_result = bulk_dot(make_span(x), make_span(y)); });
+
+  // same computations, same results
+  return (raw_result == named_result) ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+// struct_example.cpp generate_sample() pattern versus normal_sample()
+//
+#include "OptionalArgument/normal_sampler.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace OptionalArgument;
+
+constexpr size_t n = 10'000'000;
+
+// generate_sample() without the std::cout: engine built per call,
+// one sample at a time, truncation tested per sample
+void
+per_sample(std::vector<double>& sample, const bool truncated)
+{
+  std::random_device rd{};
+  std::mt19937 gen{rd()};
+
+  std::normal_distribution<> d{0, 1};
+
+  for (size_t i = 0; i < sample.size(); i++)
+  {
+    auto x = d(gen);
+    if (truncated)
+    {
+      x = std::abs(x);
+    }
+    sample[i] = x;
+  }
+}
+
+template <typename RUN>
+void
+run(const char* name, RUN run)
+{
+  const auto start = std::chrono::steady_clock::now();
+  run();
+  const auto stop = std::chrono::steady_clock::now();
+
+  std::cout << name << ": " << std::chrono::duration<double, std::nano>(stop - start).count() / n
+            << " ns/sample" << std::endl;
+}
+
+int
+main()
+{
+  std::vector<double> sample(n);
+
+  run("generate_sample() pattern     ", [&]() { per_sample(sample, true); });
+  run("normal_sample()               ", [&]() { normal_sample(sample, truncated_sample); });
+  run("normal_sample(), all threads  ",
+      [&]() { normal_sample(sample, truncated_sample, sample_threads = 0); });
+}
@@ -0,0 +1,85 @@
+// Tunes the block size of a blocked matrix transposition on its
+// runtime, saves the best configuration as a preset and reloads it.
+//
+#include "OptionalArgument/option_autotuner.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace OptionalArgument;
+
+using Block_Size          = Named_Type<struct Block_Size_Tag, size_t>;
+constexpr auto block_size = typename Block_Size::argument_syntactic_sugar();
+
+using Unroll_Inner          = Named_Type<struct Unroll_Inner_Tag, int>;
+constexpr auto unroll_inner = typename Unroll_Inner::argument_syntactic_sugar();
+
+// b = transpose(a), a is n x n
+template <typename... USER_OPTIONS>
+void
+transpose(const std::vector<double>& a, std::vector<double>& b, const size_t n,
+          USER_OPTIONS&&... user_options)
+{
+  Block_Size block_size{8};
+  Unroll_Inner unroll_inner{0};
+
+  auto options = take_optional_argument_ref(block_size, unroll_inner);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  const size_t bs = block_size.value();
+  for (size_t i_0 = 0; i_0 < n; i_0 += bs)
+  {
+    for (size_t j_0 = 0; j_0 < n; j_0 += bs)
+    {
+      const size_t i_end = std::min(i_0 + bs, n), j_end = std::min(j_0 + bs, n);
+      for (size_t i = i_0; i < i_end; ++i)
+      {
+        size_t j = j_0;
+        if (unroll_inner.value())
+        {
+          for (; j + 4 <= j_end; j += 4)
+          {
+            b[j * n + i]       = a[i * n + j];
+            b[(j + 1) * n + i] = a[i * n + j + 1];
+            b[(j + 2) * n + i] = a[i * n + j + 2];
+            b[(j + 3) * n + i] = a[i * n + j + 3];
+          }
+        }
+        for (; j < j_end; ++j) b[j * n + i] = a[i * n + j];
+      }
+    }
+  }
+}
+
+int
+main()
+{
+  const size_t n = 2048;
+  std::vector<double> a(n * n, 1), b(n * n);
+
+  const auto result = autotune(
+      benchmark_cost([&](const auto& candidate) { transpose(a, b, n, candidate); }),
+      std::make_tuple(tuning_choices<Block_Size>({4, 8, 16, 32, 64, 128, 256, 512}),
+                      tuning_choices<Unroll_Inner>({0, 1})),
+      tuning_budget = 16);
+
+  std::cout << "default: " << benchmark_cost([&](const auto&) { transpose(a, b, n); })(0)
+            << " s" << std::endl;
+  std::cout << "tuned:   " << result.best_cost << " s (" << result.evaluations
+            << " configurations)" << std::endl;
+
+  {
+    std::ofstream file("transpose_preset.txt");
+    save_option_preset(file, result.best);
+  }
+
+  // later, or in another process
+  std::ifstream file("transpose_preset.txt");
+  const auto preset = load_option_preset<Optional_Argument<Block_Size, Unroll_Inner>>(file);
+
+  transpose(a, b, n, preset);
+  std::cout << "preset:  block_size " << std::get<0>(preset)->value() << " unroll_inner "
+            << std::get<1>(preset)->value() << std::endl;
+}
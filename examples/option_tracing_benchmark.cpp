@@ -0,0 +1,158 @@
+// Shows how to trace resolved options and checks that, without a
+// tracer, the hook compiles away: optional_argument() (which is
+// traced_optional_argument(No_Option_Tracer(), ...)) is compared with
+// the dispatch as it was before the hook (untraced_optional_argument()
+// below) and with hand-written slot assignments.
+//
+// For codegen inspection, compile with -O2 -S: algorithm<Hooked>,
+// algorithm<Untraced> and algorithm<Direct> produce the same
+// instructions.
+//
+#include "OptionalArgument/optional_argument.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace OptionalArgument;
+
+using Absolute_Precision          = Named_Type<struct Absolute_Precision_Tag, double>;
+constexpr auto absolute_precision = typename Absolute_Precision::argument_syntactic_sugar();
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Starting_Point          = Named_Type<struct Starting_Point_Tag, std::vector<double>>;
+constexpr auto starting_point = typename Starting_Point::argument_syntactic_sugar();
+
+// The dispatch before the tracing hook, kept as the reference
+//
+template <typename... OPTIONs, typename... USER_OPTIONs>
+void
+untraced_optional_argument(Optional_Argument<OPTIONs...>& options,
+                           USER_OPTIONs&&... user_options) noexcept
+{
+  static_assert(Is_Free_Of_Duplicate_Type_v<Option_Decay_t<USER_OPTIONs>...>);
+  static_assert(Is_Free_Of_Duplicate_Type_v<Option_Decay_t<OPTIONs>...>);
+
+  [[maybe_unused]] auto dispatch = [&](auto&& user_option) {
+    using USER_OPTION = std::decay_t<decltype(user_option)>;
+
+    constexpr size_t occurence_count =
+        Count_Type_Occurence<USER_OPTION, std::remove_reference_t<OPTIONs>...>::value;
+    constexpr size_t occurence_count_by_value =
+        Count_Type_Occurence<USER_OPTION, OPTIONs...>::value;
+    constexpr size_t occurence_count_maybe_optional_by_value =
+        Count_Type_Occurence<std::optional<USER_OPTION>, OPTIONs...>::value;
+
+    if constexpr (occurence_count == 1)
+    {
+      std::get<std::conditional_t<occurence_count_by_value, USER_OPTION, USER_OPTION&>>(options) =
+          std::forward<decltype(user_option)>(user_option);
+    }
+    else
+    {
+      std::get<std::conditional_t<occurence_count_maybe_optional_by_value,
+                                  std::optional<USER_OPTION>, std::optional<USER_OPTION>&>>(
+          options) = std::forward<decltype(user_option)>(user_option);
+    }
+  };
+
+  (dispatch(std::forward<USER_OPTIONs>(user_options)), ...);
+}
+
+struct Print_Tracer
+{
+  void
+  operator()(const Option_Trace& trace) const
+  {
+    std::cout << "  " << trace << std::endl;
+  }
+};
+
+// DISPATCH: a tracer, or one of
+//
+struct Hooked    // optional_argument()
+{
+};
+struct Untraced  // untraced_optional_argument()
+{
+};
+struct Direct    // hand-written slot assignment (benchmark options only)
+{
+};
+
+template <typename DISPATCH, typename... USER_OPTIONS>
+[[gnu::noinline]] double
+algorithm(USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{100};
+  Absolute_Precision absolute_precision{1e-10};
+  std::optional<Starting_Point> starting_point;
+
+  auto options = take_optional_argument_ref(max_iterations, absolute_precision, starting_point);
+
+  if constexpr (std::is_same_v<DISPATCH, Hooked>)
+  {
+    optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+  }
+  else if constexpr (std::is_same_v<DISPATCH, Untraced>)
+  {
+    untraced_optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+  }
+  else if constexpr (std::is_same_v<DISPATCH, Direct>)
+  {
+    static_assert(sizeof...(USER_OPTIONS) == 2);
+    std::get<Max_Iterations&>(options)     = std::get<0>(std::forward_as_tuple(user_options...));
+    std::get<Absolute_Precision&>(options) = std::get<1>(std::forward_as_tuple(user_options...));
+  }
+  else
+  {
+    traced_optional_argument(DISPATCH(), options, std::forward<USER_OPTIONS>(user_options)...);
+  }
+
+  return max_iterations.value() * absolute_precision.value();
+}
+
+template <typename DISPATCH>
+double
+benchmark(const char* name)
+{
+  const size_t n = 10000000;
+  double sum     = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < n; ++i)
+  {
+    sum += algorithm<DISPATCH>(max_iterations = i, absolute_precision = 1e-6);
+  }
+  const auto stop = std::chrono::steady_clock::now();
+
+  std::cout << name << ": "
+            << std::chrono::duration<double, std::nano>(stop - start).count() / n << " ns/call"
+            << std::endl;
+  return sum;
+}
+
+int
+main()
+{
+  std::cout << "Traced options:" << std::endl;
+
+  std::vector<double> x(10, 1);
+  algorithm<Print_Tracer>(max_iterations = 10, starting_point = x);
+  algorithm<Print_Tracer>(absolute_precision = 1e-3, starting_point = std::move(x));
+
+  // Traced options:
+  //   Max_Iterations_Tag slot 0 wrapper move 8 bytes
+  //   Starting_Point_Tag slot 2 wrapper move 24 bytes
+  //   Absolute_Precision_Tag slot 1 wrapper move 8 bytes
+  //   Starting_Point_Tag slot 2 wrapper move 24 bytes
+
+  double checksum = 0;
+  checksum += benchmark<Hooked>("optional_argument()         ");
+  checksum += benchmark<Untraced>("untraced_optional_argument()");
+  checksum += benchmark<Direct>("direct slot assignment      ");
+
+  return checksum == 0;
+}
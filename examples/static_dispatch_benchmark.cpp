@@ -0,0 +1,113 @@
+// Runtime option branches in the inner loop versus static_dispatch()
+//
+#include "OptionalArgument/static_dispatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+using namespace OptionalArgument;
+
+enum class Norm
+{
+  L1,
+  L2,
+  Linf
+};
+
+using Norm_Option = Named_Type<struct Norm_Tag, Norm>;
+constexpr auto norm = typename Norm_Option::argument_syntactic_sugar();
+
+using Use_Weights          = Named_Type<struct Use_Weights_Tag>;
+constexpr auto use_weights = Use_Weights();
+
+template <typename... USER_OPTIONS>
+double
+branchy_norm(const std::vector<double>& x, const std::vector<double>& w,
+             USER_OPTIONS&&... user_options)
+{
+  std::optional<Use_Weights> use_weights;
+  Norm_Option norm{Norm::L2};
+
+  auto options = take_optional_argument_ref(use_weights, norm);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  double result = 0;
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    const double x_i = use_weights ? w[i] * x[i] : x[i];
+
+    switch (norm.value())
+    {
+      case Norm::L1:
+        result += std::abs(x_i);
+        break;
+      case Norm::L2:
+        result += x_i * x_i;
+        break;
+      case Norm::Linf:
+        result = std::max(result, std::abs(x_i));
+        break;
+    }
+  }
+  return (norm.value() == Norm::L2) ? std::sqrt(result) : result;
+}
+
+template <typename... USER_OPTIONS>
+double
+dispatched_norm(const std::vector<double>& x, const std::vector<double>& w,
+                USER_OPTIONS&&... user_options)
+{
+  std::optional<Use_Weights> use_weights;
+  Norm_Option norm{Norm::L2};
+
+  auto options = take_optional_argument_ref(use_weights, norm);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  return static_dispatch<Flag_Dispatch<Use_Weights>,
+                         Enum_Dispatch<Norm_Option, Norm::L1, Norm::L2, Norm::Linf>>(
+      options, [&](auto weighted, auto p) {
+        double result = 0;
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+          const double x_i = weighted ? w[i] * x[i] : x[i];
+
+          if constexpr (p == Norm::L1) result += std::abs(x_i);
+          if constexpr (p == Norm::L2) result += x_i * x_i;
+          if constexpr (p == Norm::Linf) result = std::max(result, std::abs(x_i));
+        }
+        return (p == Norm::L2) ? std::sqrt(result) : result;
+      });
+}
+
+volatile double sink;
+
+template <typename RUN>
+void
+run(const char* name, RUN run)
+{
+  constexpr size_t repetitions = 100;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < repetitions; ++r) sink = run();
+  const auto stop = std::chrono::steady_clock::now();
+
+  std::cout << name << ": "
+            << std::chrono::duration<double, std::milli>(stop - start).count() / repetitions
+            << " ms" << std::endl;
+}
+
+int
+main()
+{
+  const std::vector<double> x(1'000'000, 0.5), w(x.size(), 2);
+
+  // the option values are only known at runtime
+  const Norm p = (sink > 1) ? Norm::L2 : Norm::L1;
+
+  run("runtime branches  ", [&]() { return branchy_norm(x, w, use_weights, norm = p); });
+  run("static_dispatch() ", [&]() { return dispatched_norm(x, w, use_weights, norm = p); });
+}
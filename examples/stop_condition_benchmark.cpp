@@ -0,0 +1,65 @@
+// Cost of the stop conditions in a cheap inner loop
+//
+#include "OptionalArgument/stop_condition.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace OptionalArgument;
+
+using Deadline          = Named_Deadline<struct Deadline_Tag>;
+constexpr auto deadline = typename Deadline::argument_syntactic_sugar();
+
+using Coarse_Deadline          = Named_Deadline<struct Coarse_Deadline_Tag, Coarse_Steady_Clock>;
+constexpr auto coarse_deadline = typename Coarse_Deadline::argument_syntactic_sugar();
+
+using Cancellation          = Named_Cancellation<struct Cancellation_Tag>;
+constexpr auto cancellation = typename Cancellation::argument_syntactic_sugar();
+
+constexpr size_t n = 50'000'000;
+
+volatile double sink;
+
+// stands for one iteration of an algorithm
+template <typename SHOULD_STOP>
+void
+run(const char* name, SHOULD_STOP should_stop)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  double x = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (should_stop()) break;
+    x = std::sqrt(x + i);
+  }
+  sink = x;
+
+  const auto stop = std::chrono::steady_clock::now();
+  std::cout << name << ": " << std::chrono::duration<double, std::nano>(stop - start).count() / n
+            << " ns/iteration" << std::endl;
+}
+
+int
+main()
+{
+  const auto one_hour = std::chrono::hours(1);
+
+  run("no stop condition      ", []() { return false; });
+
+  const auto limit = std::chrono::steady_clock::now() + one_hour;
+  run("steady_clock::now()    ", [&]() { return std::chrono::steady_clock::now() >= limit; });
+
+  Deadline d = (deadline = one_hour);
+  run("Named_Deadline (64)    ", [&]() { return d.should_stop(); });
+
+  Coarse_Deadline c = (coarse_deadline = one_hour).with_poll_period(1);
+  run("Coarse_Steady_Clock (1)", [&]() { return c.should_stop(); });
+
+  Cancellation_Flag flag;
+  const Cancellation cancel = (cancellation = flag);
+  run("Named_Cancellation     ", [&]() { return cancel.should_stop(); });
+
+  run("deadline + cancellation", [&]() { return should_stop(d, cancel); });
+}
@@ -0,0 +1,275 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <valarray>
+
+namespace OptionalArgument
+{
+  //////////////// hash_bytes() ////////////////
+  //
+  // Fast (non cryptographic) hash of raw memory, processed by 8 bytes
+  // words. Used to key caches on argument contents.
+  //
+  constexpr std::uint64_t
+  hash_mix(std::uint64_t h) noexcept
+  {
+    // murmur3 finalizer
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+  }
+
+  inline std::size_t
+  hash_bytes(const void* data, std::size_t n, std::uint64_t seed = 0x9e3779b97f4a7c15ull) noexcept
+  {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t h        = seed ^ (n * 0xff51afd7ed558ccdull);
+
+    for (; n >= 8; n -= 8, p += 8)
+    {
+      std::uint64_t w;
+      std::memcpy(&w, p, 8);
+      h = (h ^ hash_mix(w)) * 0x9e3779b97f4a7c15ull;
+    }
+    if (n)
+    {
+      std::uint64_t w = 0;
+      std::memcpy(&w, p, n);
+      h = (h ^ hash_mix(w)) * 0x9e3779b97f4a7c15ull;
+    }
+    return static_cast<std::size_t>(hash_mix(h));
+  }
+
+  constexpr std::size_t
+  hash_combine(std::size_t seed, std::size_t h) noexcept
+  {
+    return static_cast<std::size_t>(
+        hash_mix(static_cast<std::uint64_t>(seed) ^ (h + 0x9e3779b97f4a7c15ull + (seed << 6))));
+  }
+
+  //////////////// Is_Contiguous_Range ////////////////
+  //
+  // Tests if T provides data() and size() (std::vector, std::array,
+  // std::string...)
+  //
+  template <typename T, typename = void>
+  struct Is_Contiguous_Range : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct Is_Contiguous_Range<T, std::void_t<decltype(std::declval<const T&>().data()),
+                                            decltype(std::declval<const T&>().size())>>
+      : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Contiguous_Range_v = Is_Contiguous_Range<T>::value;
+
+  //////////////// Is_Range ////////////////
+  //
+  template <typename T, typename = void>
+  struct Is_Range : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct Is_Range<T, std::void_t<decltype(std::begin(std::declval<const T&>())),
+                                 decltype(std::end(std::declval<const T&>()))>> : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Range_v = Is_Range<T>::value;
+
+  //////////////// Is_Tuple_Like ////////////////
+  //
+  template <typename T, typename = void>
+  struct Is_Tuple_Like : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct Is_Tuple_Like<T, std::void_t<decltype(std::tuple_size<T>::value)>> : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Tuple_Like_v = Is_Tuple_Like<T>::value;
+
+  //////////////// Is_Valarray ////////////////
+  //
+  template <typename T>
+  struct Is_Valarray : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct Is_Valarray<std::valarray<T>> : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Valarray_v = Is_Valarray<T>::value;
+
+  //////////////// Argument_Hash ////////////////
+  //
+  // Hashes argument contents, consistently with their equality:
+  // - floating point           -> by value (+0.0 and -0.0 hash the same)
+  // - other arithmetic, enum   -> raw bytes
+  // - contiguous ranges and std::valarray of values with unique object
+  //   representations (integers, enums, no padding) -> raw bytes
+  // - other ranges             -> element by element
+  // - tuple like               -> element by element
+  // - otherwise                -> std::hash
+  //
+  struct Argument_Hash
+  {
+    template <typename T>
+    std::size_t
+    operator()(const T& t) const
+    {
+      if constexpr (std::is_floating_point_v<T>)
+      {
+        const T normalized = (t == 0 ? T(0) : t);
+        return hash_bytes(&normalized, sizeof(T));
+      }
+      else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+      {
+        return hash_bytes(&t, sizeof(T));
+      }
+      else if constexpr (Is_Contiguous_Range_v<T>)
+      {
+        using value_type = std::remove_cv_t<std::remove_pointer_t<decltype(t.data())>>;
+
+        if constexpr (std::has_unique_object_representations_v<value_type>)
+        {
+          return hash_bytes(t.data(), t.size() * sizeof(value_type));
+        }
+        else
+        {
+          return hash_range(t);
+        }
+      }
+      else if constexpr (Is_Valarray_v<T>)
+      {
+        using value_type = typename T::value_type;
+
+        if constexpr (std::has_unique_object_representations_v<value_type>)
+        {
+          // CAVEAT: &t[0] is UB for empty valarray
+          return t.size() ? hash_bytes(&t[0], t.size() * sizeof(value_type))
+                          : hash_bytes(nullptr, 0);
+        }
+        else
+        {
+          return hash_range(t);
+        }
+      }
+      else if constexpr (Is_Range_v<T>)
+      {
+        return hash_range(t);
+      }
+      else if constexpr (Is_Tuple_Like_v<T>)
+      {
+        return std::apply(
+            [this](const auto&... t_i) {
+              std::size_t h = sizeof...(t_i);
+              ((h = hash_combine(h, (*this)(t_i))), ...);
+              return h;
+            },
+            t);
+      }
+      else
+      {
+        return std::hash<T>()(t);
+      }
+    }
+
+   private:
+    template <typename T>
+    std::size_t
+    hash_range(const T& t) const
+    {
+      std::size_t h = 0;
+      for (const auto& t_i : t) h = hash_combine(h, (*this)(t_i));
+      return h;
+    }
+  };
+
+  //////////////// Argument_Tolerance_Equal ////////////////
+  //
+  // Compares argument contents, floating point values are considered
+  // equal if |a-b|<=tolerance. With tolerance=0 this is the usual
+  // equality, except that std::valarray is properly handled.
+  //
+  struct Argument_Tolerance_Equal
+  {
+    double tolerance = 0;
+
+    template <typename T0, typename T1>
+    bool
+    operator()(const T0& t0, const T1& t1) const
+    {
+      // T0 and T1 may only differ by references (tuple of values
+      // versus tuple of references)
+      //
+      using T = std::decay_t<T0>;
+
+      if constexpr (std::is_floating_point_v<T>)
+      {
+        return (tolerance == 0) ? t0 == t1 : std::abs(t0 - t1) <= tolerance;
+      }
+      else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+      {
+        return t0 == t1;
+      }
+      else if constexpr (Is_Range_v<T>)
+      {
+        if (std::size(t0) != std::size(t1)) return false;
+
+        auto t1_i = std::begin(t1);
+        for (const auto& t0_i : t0)
+        {
+          if (not(*this)(t0_i, *t1_i)) return false;
+          ++t1_i;
+        }
+        return true;
+      }
+      else if constexpr (Is_Tuple_Like_v<T>)
+      {
+        static_assert(std::tuple_size_v<T> == std::tuple_size_v<std::decay_t<T1>>);
+
+        return compare_tuple(t0, t1, std::make_index_sequence<std::tuple_size_v<T>>());
+      }
+      else
+      {
+        return t0 == t1;
+      }
+    }
+
+   private:
+    template <typename T0, typename T1, std::size_t... Is>
+    bool
+    compare_tuple(const T0& t0, const T1& t1, std::index_sequence<Is...>) const
+    {
+      return ((*this)(std::get<Is>(t0), std::get<Is>(t1)) && ...);
+    }
+  };
+
+}  // namespace OptionalArgument
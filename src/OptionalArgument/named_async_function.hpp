@@ -0,0 +1,304 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "named_std_function.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Thread_Pool_Executor ////////////////
+  //
+  // Fixed number of worker threads and a FIFO task queue. The
+  // destructor runs the pending tasks, then joins.
+  //
+  //   Thread_Pool_Executor executor(4);
+  //   std::future<double> y = executor.submit([]() { return simulation(); });
+  //
+  class Thread_Pool_Executor
+  {
+   protected:
+    std::vector<std::thread> _workers;
+    std::deque<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _task_available;
+    bool _stop = false;
+
+    void
+    work()
+    {
+      for (;;)
+      {
+        std::function<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          _task_available.wait(lock, [this]() { return _stop || not _tasks.empty(); });
+
+          if (_tasks.empty()) return;  // stopped and drained
+
+          task = std::move(_tasks.front());
+          _tasks.pop_front();
+        }
+        task();
+      }
+    }
+
+   public:
+    explicit Thread_Pool_Executor(
+        const std::size_t n_threads = std::max(1u, std::thread::hardware_concurrency()))
+    {
+      assert(n_threads > 0);
+
+      _workers.reserve(n_threads);
+      for (std::size_t i = 0; i < n_threads; ++i) _workers.emplace_back([this]() { work(); });
+    }
+
+    ~Thread_Pool_Executor()
+    {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+      }
+      _task_available.notify_all();
+      for (auto& worker : _workers) worker.join();
+    }
+
+    Thread_Pool_Executor(const Thread_Pool_Executor&) = delete;
+    Thread_Pool_Executor& operator=(const Thread_Pool_Executor&) = delete;
+
+    std::size_t
+    size() const
+    {
+      return _workers.size();
+    }
+
+    // Exceptions thrown by f are rethrown by future::get()
+    //
+    template <typename F>
+    std::future<std::invoke_result_t<std::decay_t<F>>>
+    submit(F&& f)
+    {
+      using RESULT = std::invoke_result_t<std::decay_t<F>>;
+
+      // std::function needs a copyable target
+      auto task = std::make_shared<std::packaged_task<RESULT()>>(std::forward<F>(f));
+      std::future<RESULT> result = task->get_future();
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.emplace_back([task]() { (*task)(); });
+      }
+      _task_available.notify_one();
+
+      return result;
+    }
+  };
+
+  // Shared by the Named_Async_Function created without an explicit
+  // executor
+  //
+  inline std::shared_ptr<Thread_Pool_Executor>
+  default_executor()
+  {
+    static const auto executor = std::make_shared<Thread_Pool_Executor>();
+    return executor;
+  }
+
+  //////////////// Named_Async_Function ////////////////
+  //
+  // Asynchronous version of Named_Std_Function: a call returns a
+  // std::future, the evaluation runs on an executor. The arguments are
+  // copied (std::decay_t<ARGS>...) into the task, then passed to the
+  // function as declared by ARGS.
+  //
+  //   using Objective_Function =
+  //       Named_Async_Function<struct Objective_Function_Tag, double, const std::vector<double>&>;
+  //   constexpr auto objective_function = Argument_Syntactic_Sugar<Objective_Function>();
+  //
+  //   my_algorithm(objective_function = simulation, x);
+  //
+  // and in my_algorithm:
+  //
+  //   auto in_flight = f.batch(candidates);  // all the points at once
+  //   ...                                    // bookkeeping, overlaps the evaluations
+  //   for (auto& y : in_flight) use(y.get());
+  //
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  class Named_Async_Function;
+
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  struct Argument_Syntactic_Sugar<Named_Async_Function<TAG, OUTPUT, ARGS...>,
+                                  typename Named_Async_Function<TAG, OUTPUT, ARGS...>::value_type>
+  {
+    Named_Async_Function<TAG, OUTPUT, ARGS...> operator=(OUTPUT(f)(ARGS...)) const
+    {
+      return Named_Async_Function<TAG, OUTPUT, ARGS...>{f};
+    }
+    template <typename _F>
+    std::enable_if_t<std::is_invocable_r_v<OUTPUT, std::decay_t<_F>, ARGS...>,
+                     Named_Async_Function<TAG, OUTPUT, ARGS...>>
+    operator=(_F&& f) const
+    {
+      return Named_Async_Function<TAG, OUTPUT, ARGS...>{std::forward<_F>(f)};
+    }
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  class Named_Async_Function
+  {
+   public:
+    using tag_type      = TAG;
+    using value_type    = std::function<OUTPUT(ARGS...)>;
+    using future_type   = std::future<OUTPUT>;
+    using argument_type = std::tuple<std::decay_t<ARGS>...>;
+
+   protected:
+    // shared: tasks may outlive this object
+    std::shared_ptr<const value_type> _f;
+    std::shared_ptr<Thread_Pool_Executor> _executor;
+
+    template <typename TUPLE>
+    future_type
+    submit(TUPLE&& arguments) const
+    {
+      // the task owns its arguments: passed as declared by ARGS
+      // (by value, moved ones included, or by non-const reference)
+      return _executor->submit(
+          [f = _f, arguments = std::forward<TUPLE>(arguments)]() mutable -> OUTPUT {
+            return std::apply(
+                [&f](auto&... args) -> OUTPUT { return (*f)(std::forward<ARGS>(args)...); },
+                arguments);
+          });
+    }
+
+   public:
+    Named_Async_Function() = default;
+
+    template <typename _F,
+              typename = std::enable_if_t<
+                  std::is_invocable_r_v<OUTPUT, _F, ARGS...> &&
+                  not std::is_same_v<std::decay_t<_F>, Named_Async_Function>>>
+    explicit Named_Async_Function(
+        _F&& f, std::shared_ptr<Thread_Pool_Executor> executor = default_executor())
+        : _f{std::make_shared<const value_type>(std::forward<_F>(f))},
+          _executor{std::move(executor)}
+    {
+    }
+
+    bool
+    is_empty() const
+    {
+      return not(_f && *_f);
+    }
+
+    // Same function, evaluated on another executor
+    //
+    Named_Async_Function
+    with_executor(std::shared_ptr<Thread_Pool_Executor> executor) const
+    {
+      Named_Async_Function copy(*this);
+      copy._executor = std::move(executor);
+      return copy;
+    }
+
+    const std::shared_ptr<Thread_Pool_Executor>&
+    executor() const
+    {
+      return _executor;
+    }
+
+    future_type
+    operator()(ARGS... args) const
+    {
+      assert(not is_empty());
+      return submit(argument_type(std::forward<ARGS>(args)...));
+    }
+
+    // Submits all the points at once. A point is the argument itself
+    // for a one argument function, a tuple of arguments otherwise.
+    //
+    template <typename POINTS>
+    std::vector<future_type>
+    batch(const POINTS& points) const
+    {
+      assert(not is_empty());
+
+      std::vector<future_type> futures;
+      futures.reserve(std::size(points));
+
+      for (const auto& point : points) futures.push_back(submit(argument_type(point)));
+
+      return futures;
+    }
+
+    // Synchronous call, for code written for Named_Std_Function
+    //
+    OUTPUT
+    wait(ARGS... args) const
+    {
+      return (*this)(std::forward<ARGS>(args)...).get();
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Async_Function>;
+  };
+
+  // Named_Std_Function -> Named_Async_Function with the same tag
+  //
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  Named_Async_Function<TAG, OUTPUT, ARGS...>
+  make_async(const Named_Std_Function<TAG, OUTPUT, ARGS...>& f,
+             std::shared_ptr<Thread_Pool_Executor> executor = default_executor())
+  {
+    assert(not f.is_empty());
+
+    return Named_Async_Function<TAG, OUTPUT, ARGS...>(
+        [f](ARGS... args) -> OUTPUT { return f(std::forward<ARGS>(args)...); },
+        std::move(executor));
+  }
+
+  //////////////// wait_all() ////////////////
+  //
+  // Collects the results in submission order
+  //
+  template <typename OUTPUT>
+  std::vector<OUTPUT>
+  wait_all(std::vector<std::future<OUTPUT>>& futures)
+  {
+    std::vector<OUTPUT> results;
+    results.reserve(futures.size());
+
+    for (auto& future : futures) results.push_back(future.get());
+    return results;
+  }
+
+  // Waits for completion, rethrows the first exception
+  //
+  inline void
+  wait_all(std::vector<std::future<void>>& futures)
+  {
+    for (auto& future : futures) future.get();
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,287 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "named_type_array.hpp"
+#include "option_validation.hpp"
+#include "optional_argument_core.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Broadcast_View ////////////////
+  //
+  // Uniform access to a scalar or a vector: view[i] reads
+  // data[i * stride], with stride = 0 for a broadcasted scalar and 1
+  // for a vector. No branch in the loop body.
+  //
+  // extent() is the number of stored components: 1 for a scalar.
+  //
+  template <typename T>
+  class Broadcast_View
+  {
+   public:
+    using value_type = T;
+
+   protected:
+    const T* _data;
+    std::size_t _stride;
+    std::size_t _extent;
+
+   public:
+    constexpr Broadcast_View(const T* data, const std::size_t stride,
+                             const std::size_t extent) noexcept
+        : _data(data), _stride(stride), _extent(extent)
+    {
+      assert(stride <= 1);
+      assert(stride == 1 || extent == 1);
+    }
+
+    constexpr const T&
+    operator[](const std::size_t i) const noexcept
+    {
+      return _data[i * _stride];
+    }
+
+    constexpr const T*
+    data() const noexcept
+    {
+      return _data;
+    }
+
+    constexpr std::size_t
+    stride() const noexcept
+    {
+      return _stride;
+    }
+
+    constexpr std::size_t
+    extent() const noexcept
+    {
+      return _extent;
+    }
+
+    constexpr bool
+    is_scalar() const noexcept
+    {
+      return _stride == 0;
+    }
+  };
+
+  // A scalar is a 1-element array, broadcasted by
+  // Elementwise_Relation
+  //
+  template <typename T>
+  Contiguous_View<T>
+  contiguous_view(const Broadcast_View<T>& view)
+  {
+    return {view.data(), view.extent(), view.is_scalar()};
+  }
+
+  //////////////// Scalar_Broadcast ////////////////
+  //
+  // Compile-time scalar case: s[i] is the scalar, whatever i. Kernels
+  // written for an indexable BOUND are specialized by
+  // Named_Broadcast_Vector::visit().
+  //
+  template <typename T>
+  class Scalar_Broadcast
+  {
+   public:
+    using value_type = T;
+
+   protected:
+    T _value;
+
+   public:
+    constexpr explicit Scalar_Broadcast(const T& value) : _value(value) {}
+
+    constexpr const T&
+    operator[](const std::size_t) const noexcept
+    {
+      return _value;
+    }
+
+    constexpr const T&
+    value() const noexcept
+    {
+      return _value;
+    }
+  };
+
+  //////////////// Named_Broadcast_Vector ////////////////
+  //
+  // A vector-valued option (bounds, weights...) that also accepts a
+  // scalar, broadcasted to all components without allocating an
+  // n-element vector:
+  //
+  //   template <typename T>
+  //   using Lower_Bounds = Named_Broadcast_Vector<struct Lower_Bounds_Tag, T>;
+  //   template <typename T>
+  //   constexpr auto lower_bounds = typename Lower_Bounds<T>::argument_syntactic_sugar();
+  //
+  //   algorithm(x, lower_bounds<double> = 0);
+  //   algorithm(x, lower_bounds<double> = std::vector<double>{0, -1, 0});
+  //
+  // The algorithm either uses the branch-free view:
+  //
+  //   const auto lb = lower_bound.view();
+  //   for (std::size_t i = 0; i < n; ++i) x[i] = std::max(x[i], lb[i]);
+  //
+  // or gets a kernel instantiated for each case (Scalar_Broadcast<T>
+  // or Span<const T>):
+  //
+  //   lower_bound.visit([&](const auto& lb) { project(x, lb); });
+  //
+  template <typename TAG, typename T>
+  class Named_Broadcast_Vector;
+
+  template <typename TAG, typename T>
+  struct Argument_Syntactic_Sugar<Named_Broadcast_Vector<TAG, T>, T>
+  {
+    Named_Broadcast_Vector<TAG, T>
+    operator=(const T& scalar) const
+    {
+      return Named_Broadcast_Vector<TAG, T>{scalar};
+    }
+    Named_Broadcast_Vector<TAG, T>
+    operator=(std::vector<T> vector) const
+    {
+      return Named_Broadcast_Vector<TAG, T>{std::move(vector)};
+    }
+    Named_Broadcast_Vector<TAG, T>
+    operator=(std::initializer_list<T> vector) const
+    {
+      return Named_Broadcast_Vector<TAG, T>{std::vector<T>(vector)};
+    }
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  template <typename TAG, typename T>
+  class Named_Broadcast_Vector
+  {
+   public:
+    using tag_type   = TAG;
+    using value_type = T;
+
+    static_assert(std::is_arithmetic_v<T>);
+
+   protected:
+    std::vector<T> _vector;
+    T _scalar;
+    bool _is_scalar;
+
+   public:
+    explicit Named_Broadcast_Vector(const T scalar = T())
+        : _vector(), _scalar(scalar), _is_scalar(true)
+    {
+    }
+    explicit Named_Broadcast_Vector(std::vector<T> vector)
+        : _vector(std::move(vector)), _scalar(), _is_scalar(false)
+    {
+    }
+
+    bool
+    is_scalar() const noexcept
+    {
+      return _is_scalar;
+    }
+
+    // Vector size, 0 for a scalar (compatible with any size)
+    //
+    std::size_t
+    size() const noexcept
+    {
+      return _vector.size();
+    }
+
+    bool
+    is_compatible_size(const std::size_t n) const noexcept
+    {
+      return _is_scalar || _vector.size() == n;
+    }
+
+    const T&
+    scalar() const noexcept
+    {
+      assert(_is_scalar);
+      return _scalar;
+    }
+
+    const std::vector<T>&
+    vector() const noexcept
+    {
+      assert(not _is_scalar);
+      return _vector;
+    }
+
+    Broadcast_View<T>
+    view() const noexcept
+    {
+      return _is_scalar ? Broadcast_View<T>(&_scalar, 0, 1)
+                        : Broadcast_View<T>(_vector.data(), 1, _vector.size());
+    }
+
+    // The view is also the option value, for option_constraint()
+    //
+    Broadcast_View<T>
+    value() const noexcept
+    {
+      return view();
+    }
+
+    template <typename KERNEL>
+    decltype(auto)
+    visit(KERNEL&& kernel) const
+    {
+      if (_is_scalar) return std::forward<KERNEL>(kernel)(Scalar_Broadcast<T>(_scalar));
+
+      return std::forward<KERNEL>(kernel)(Span<const T>(_vector.data(), _vector.size()));
+    }
+
+    friend bool
+    operator==(const Named_Broadcast_Vector& a, const Named_Broadcast_Vector& b)
+    {
+      return (a._is_scalar == b._is_scalar) &&
+             (a._is_scalar ? a._scalar == b._scalar : a._vector == b._vector);
+    }
+    friend bool
+    operator!=(const Named_Broadcast_Vector& a, const Named_Broadcast_Vector& b)
+    {
+      return not(a == b);
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Broadcast_Vector>;
+  };
+
+  template <typename TAG, typename T>
+  std::ostream&
+  operator<<(std::ostream& out, const Named_Broadcast_Vector<TAG, T>& to_print)
+  {
+    if (to_print.is_scalar())
+    {
+      out << to_print.scalar() << " (broadcast)";
+    }
+    else
+    {
+      for (const auto& component : to_print.vector()) out << component << " ";
+    }
+
+    return out;
+  }
+
+}  // namespace OptionalArgument
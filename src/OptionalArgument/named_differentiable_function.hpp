@@ -0,0 +1,184 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "named_type_array.hpp"
+#include "optional_argument_core.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Named_Differentiable_Function ////////////////
+  //
+  // Objective function with gradient, implemented once in fused form
+  // (value and gradient share most of their computation):
+  //
+  //   T f(Span<const T> x, Span<T> gradient)
+  //
+  // returns f(x) and, unless gradient is empty, writes grad f(x) into
+  // the caller buffer gradient. The algorithm uses:
+  //
+  //   f.value(x)                         // f(x), gradient skipped
+  //   f.value_and_gradient(x, gradient)  // f(x), gradient filled
+  //   f.gradient(x, gradient)            // gradient filled
+  //
+  // nothing being allocated by the calls. If the user functor also
+  // has a cheaper value only overload T(Span<const T>), value() uses
+  // it.
+  //
+  //   template <typename T>
+  //   using Objective_Function = Named_Differentiable_Function<struct Objective_Function_Tag, T>;
+  //   template <typename T>
+  //   constexpr auto objective_function =
+  //       typename Objective_Function<T>::argument_syntactic_sugar();
+  //
+  //   my_algorithm(x, objective_function<double> = Rosenbrock_with_Gradient());
+  //
+  template <typename TAG, typename T>
+  class Named_Differentiable_Function;
+
+  template <typename TAG, typename T>
+  struct Argument_Syntactic_Sugar<Named_Differentiable_Function<TAG, T>,
+                                  typename Named_Differentiable_Function<TAG, T>::value_type>
+  {
+    Named_Differentiable_Function<TAG, T> operator=(T(f)(Span<const T>, Span<T>)) const
+    {
+      return Named_Differentiable_Function<TAG, T>{f};
+    }
+    template <typename _F>
+    std::enable_if_t<std::is_invocable_r_v<T, std::decay_t<_F>&, Span<const T>, Span<T>>,
+                     Named_Differentiable_Function<TAG, T>>
+    operator=(_F&& f) const
+    {
+      return Named_Differentiable_Function<TAG, T>{std::forward<_F>(f)};
+    }
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  template <typename TAG, typename T>
+  class Named_Differentiable_Function
+  {
+   public:
+    using tag_type      = TAG;
+    using point_type    = Span<const T>;
+    using gradient_type = Span<T>;
+    using value_type    = std::function<T(point_type, gradient_type)>;  // fused form
+
+   protected:
+    value_type _value_and_gradient;
+    std::function<T(point_type)> _value;  // empty: derived from the fused form
+
+   public:
+    Named_Differentiable_Function() = default;
+
+    // The functor is always shared: both forms and all the copies of
+    // this object call the same functor object (a stateful functor
+    // sees all the evaluations)
+    //
+    template <typename _F,
+              typename = std::enable_if_t<
+                  std::is_invocable_r_v<T, std::decay_t<_F>&, point_type, gradient_type> &&
+                  not std::is_same_v<std::decay_t<_F>, Named_Differentiable_Function>>>
+    explicit Named_Differentiable_Function(_F&& f)
+    {
+      using F = std::decay_t<_F>;
+
+      auto shared = std::make_shared<F>(std::forward<_F>(f));
+
+      _value_and_gradient = [shared](point_type x, gradient_type gradient) {
+        return (*shared)(x, gradient);
+      };
+      if constexpr (std::is_invocable_r_v<T, F&, point_type>)
+      {
+        _value = [shared](point_type x) { return (*shared)(x); };
+      }
+    }
+
+    bool
+    is_empty() const
+    {
+      return static_cast<bool>(_value_and_gradient) == false;
+    }
+
+    // true if the user provided a value only overload
+    //
+    bool
+    has_value_form() const
+    {
+      return static_cast<bool>(_value);
+    }
+
+    T
+    value(const point_type x) const
+    {
+      assert(not is_empty());
+
+      return _value ? _value(x) : _value_and_gradient(x, gradient_type());
+    }
+
+    T
+    value_and_gradient(const point_type x, const gradient_type gradient) const
+    {
+      assert(not is_empty());
+      assert(gradient.size() == x.size());
+
+      return _value_and_gradient(x, gradient);
+    }
+
+    void
+    gradient(const point_type x, const gradient_type gradient) const
+    {
+      value_and_gradient(x, gradient);
+    }
+
+    T
+    operator()(const point_type x) const
+    {
+      return value(x);
+    }
+
+    // std::vector conveniences
+    //
+    T
+    value(const std::vector<T>& x) const
+    {
+      return value(point_type(x.data(), x.size()));
+    }
+
+    T
+    value_and_gradient(const std::vector<T>& x, std::vector<T>& gradient) const
+    {
+      return value_and_gradient(point_type(x.data(), x.size()),
+                                gradient_type(gradient.data(), gradient.size()));
+    }
+
+    void
+    gradient(const std::vector<T>& x, std::vector<T>& gradient) const
+    {
+      value_and_gradient(x, gradient);
+    }
+
+    T
+    operator()(const std::vector<T>& x) const
+    {
+      return value(x);
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Differentiable_Function>;
+  };
+
+}  // namespace OptionalArgument
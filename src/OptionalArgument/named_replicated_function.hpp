@@ -0,0 +1,170 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "named_std_function.hpp"
+#include "thread_index.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace OptionalArgument
+{
+  //////////////// Named_Replicated_Function ////////////////
+  //
+  // Named_Std_Function for stateful functors (scratch buffers,
+  // counters...) evaluated from several threads: each thread calls
+  // its own replica, a copy of the user functor made by its first
+  // call. No lock, no shared state between threads.
+  //
+  //   using Objective_Function = Named_Replicated_Function<struct Objective_Function_Tag, double,
+  //                                                        const std::vector<double>&>;
+  //   constexpr auto objective_function = Argument_Syntactic_Sugar<Objective_Function>();
+  //
+  //   my_parallel_algorithm(objective_function = Rosenbrock_as_Struct<double>(), x);
+  //
+  // Per-thread state is merged afterwards, when no evaluation is
+  // running:
+  //
+  //   f.reduce<Rosenbrock_as_Struct<double>>([&](const auto& replica) { ... });
+  //
+  // Replicas are stored in cache line aligned slots indexed by
+  // thread_index(). A slot outlives its thread: a new thread getting
+  // the same index reuses the replica. All copies share the same
+  // replicas.
+  //
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  class Named_Replicated_Function;
+
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  struct Argument_Syntactic_Sugar<
+      Named_Replicated_Function<TAG, OUTPUT, ARGS...>,
+      typename Named_Replicated_Function<TAG, OUTPUT, ARGS...>::value_type>
+  {
+    Named_Replicated_Function<TAG, OUTPUT, ARGS...> operator=(OUTPUT(f)(ARGS...)) const
+    {
+      return Named_Replicated_Function<TAG, OUTPUT, ARGS...>{f};
+    }
+    template <typename _F>
+    std::enable_if_t<std::is_invocable_r_v<OUTPUT, std::decay_t<_F>&, ARGS...>,
+                     Named_Replicated_Function<TAG, OUTPUT, ARGS...>>
+    operator=(_F&& f) const
+    {
+      return Named_Replicated_Function<TAG, OUTPUT, ARGS...>{std::forward<_F>(f)};
+    }
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  class Named_Replicated_Function
+  {
+   public:
+    using tag_type   = TAG;
+    using value_type = std::function<OUTPUT(ARGS...)>;
+
+   protected:
+    struct alignas(cache_line_size) Replica_Slot
+    {
+      std::optional<value_type> replica;
+    };
+
+    struct State
+    {
+      const value_type prototype;
+      Replica_Slot slots[max_thread_indices];
+
+      explicit State(value_type&& f) : prototype(std::move(f)) {}
+    };
+
+    std::shared_ptr<State> _state;
+
+   public:
+    Named_Replicated_Function() = default;
+
+    template <typename _F,
+              typename = std::enable_if_t<
+                  std::is_invocable_r_v<OUTPUT, std::decay_t<_F>&, ARGS...> &&
+                  not std::is_same_v<std::decay_t<_F>, Named_Replicated_Function>>>
+    explicit Named_Replicated_Function(_F&& f)
+        : _state{std::make_shared<State>(value_type(std::forward<_F>(f)))}
+    {
+    }
+
+    bool
+    is_empty() const
+    {
+      return not(_state && _state->prototype);
+    }
+
+    // Replica of the calling thread
+    //
+    value_type&
+    replica() const
+    {
+      assert(not is_empty());
+
+      Replica_Slot& slot = _state->slots[thread_index()];
+      if (not slot.replica.has_value()) slot.replica.emplace(_state->prototype);
+
+      return *slot.replica;
+    }
+
+    OUTPUT
+    operator()(ARGS... args) const { return replica()(std::forward<ARGS>(args)...); }
+
+    std::size_t
+    replica_count() const
+    {
+      if (is_empty()) return 0;
+
+      std::size_t count = 0;
+      for (const auto& slot : _state->slots) count += slot.replica.has_value();
+      return count;
+    }
+
+    // Calls reduce(F& replica) for each replica, F being the type of
+    // the user functor. No evaluation must be running.
+    //
+    template <typename F, typename REDUCE>
+    void
+    reduce(REDUCE&& reduce) const
+    {
+      if (is_empty()) return;
+
+      for (auto& slot : _state->slots)
+      {
+        if (not slot.replica.has_value()) continue;
+
+        F* replica = slot.replica->template target<F>();
+        assert(replica != nullptr);
+        reduce(*replica);
+      }
+    }
+
+    // Next calls start from fresh copies of the user functor. No
+    // evaluation must be running.
+    //
+    void
+    clear_replicas() const
+    {
+      if (is_empty()) return;
+
+      for (auto& slot : _state->slots) slot.replica.reset();
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Replicated_Function>;
+  };
+
+}  // namespace OptionalArgument
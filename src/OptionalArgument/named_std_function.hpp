@@ -0,0 +1,90 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+OPTIONAL_ARGUMENT_EXPORT namespace OptionalArgument
+{
+  //////////////// Named_Std_Function ////////////////
+  //
+  // Specialization for extended capture
+  //
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  class Named_Std_Function;
+
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  struct Argument_Syntactic_Sugar<Named_Std_Function<TAG, OUTPUT, ARGS...>,
+                                  typename Named_Std_Function<TAG, OUTPUT, ARGS...>::value_type>
+  {
+    Named_Std_Function<TAG, OUTPUT, ARGS...> operator=(OUTPUT(f)(ARGS...)) const
+    {
+      return Named_Std_Function<TAG, OUTPUT, ARGS...>{f};
+    }
+    template <typename _F>
+    std::enable_if_t<std::is_invocable_r_v<OUTPUT, std::decay_t<_F>, ARGS...>,
+                     Named_Std_Function<TAG, OUTPUT, ARGS...>>
+    operator=(_F&& f) const
+    {
+      return Named_Std_Function<TAG, OUTPUT, ARGS...>{f};
+    }
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  class Named_Std_Function
+  {
+   public:
+    using tag_type   = TAG;
+    using value_type = std::function<OUTPUT(ARGS...)>;
+
+   protected:
+    value_type _f;
+
+   public:
+    Named_Std_Function() = default;
+
+    // Named_Std_Function is itself invocable: excluded, otherwise a
+    // const rvalue copy would wrap itself recursively
+    //
+    template <typename _F,
+              typename = std::enable_if_t<
+                  std::is_invocable_r_v<OUTPUT, _F, ARGS...> &&
+                  not std::is_same_v<std::decay_t<_F>, Named_Std_Function>>>
+    explicit Named_Std_Function(_F&& f) : _f{std::forward<_F>(f)}
+    {
+    }
+
+    template <typename _F,
+              typename = std::enable_if_t<
+                  std::is_invocable_r_v<OUTPUT, std::decay_t<_F>, ARGS...> &&
+                  not std::is_same_v<std::decay_t<_F>, Named_Std_Function>>>
+    Named_Std_Function&
+    operator=(_F&& f)
+    {
+      _f = std::forward<_F>(f);
+      return *this;
+    }
+    bool
+    is_empty() const
+    {
+      return static_cast<bool>(_f) == false;
+    }
+    OUTPUT
+    operator()(ARGS... args) const { return _f(args...); }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Std_Function>;
+  };
+
+}  // namespace OptionalArgument
@@ -0,0 +1,376 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "argument_hash.hpp"
+#include "named_std_function.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Cache_Statistics ////////////////
+  //
+  struct Cache_Statistics
+  {
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
+
+    std::size_t
+    calls() const
+    {
+      return hits + misses;
+    }
+    double
+    hit_rate() const
+    {
+      return calls() ? static_cast<double>(hits) / static_cast<double>(calls()) : 0;
+    }
+  };
+
+  inline std::ostream&
+  operator<<(std::ostream& out, const Cache_Statistics& to_print)
+  {
+    out << "hits " << to_print.hits << " misses " << to_print.misses << " hit_rate "
+        << to_print.hit_rate();
+    return out;
+  }
+
+  //////////////// Last_K_Cache ////////////////
+  //
+  // Keeps the k last computed values, lookup is a linear scan. This
+  // is the policy to use for line search/restart like patterns, it
+  // also supports tolerance-based matching.
+  //
+  // Thread safety: find() takes a shared lock, insert() an exclusive
+  // one.
+  //
+  template <typename KEY, typename VALUE>
+  class Last_K_Cache
+  {
+    struct Entry
+    {
+      KEY key;
+      VALUE value;
+    };
+
+    Argument_Tolerance_Equal _equal;
+    std::vector<std::optional<Entry>> _entries;
+    std::size_t _next = 0;
+    mutable std::shared_mutex _mutex;
+
+   public:
+    Last_K_Cache(const std::size_t k, const double tolerance) : _equal{tolerance}, _entries(k)
+    {
+      assert(k > 0);
+    }
+
+    template <typename KEY_REF>
+    std::optional<VALUE>
+    find(const KEY_REF& key) const
+    {
+      std::shared_lock lock(_mutex);
+
+      // scan from the most recent entry
+      for (std::size_t i = 0; i < _entries.size(); ++i)
+      {
+        const auto& entry = _entries[(_next + _entries.size() - 1 - i) % _entries.size()];
+
+        if (entry.has_value() && _equal(entry->key, key)) return entry->value;
+      }
+      return {};
+    }
+
+    template <typename KEY_REF>
+    void
+    insert(const KEY_REF& key, const VALUE& value)
+    {
+      std::unique_lock lock(_mutex);
+
+      _entries[_next].emplace(Entry{KEY(key), value});
+      _next = (_next + 1) % _entries.size();
+    }
+
+    std::size_t
+    capacity() const
+    {
+      return _entries.size();
+    }
+  };
+
+  //////////////// LRU_Cache ////////////////
+  //
+  // Bounded cache keyed by a hash of the argument contents. Matching
+  // is exact (a tolerance is not compatible with hashing).
+  //
+  // Thread safety: lookups only take a shared lock, recency is
+  // recorded with a relaxed atomic stamp. The least recently used
+  // entry is evicted when inserting into a full cache.
+  //
+  template <typename KEY, typename VALUE, typename HASH = Argument_Hash,
+            typename EQUAL = Argument_Tolerance_Equal>
+  class LRU_Cache
+  {
+    struct Slot
+    {
+      std::optional<KEY> key;
+      std::optional<VALUE> value;
+      std::size_t hash = 0;
+      mutable std::atomic<std::uint64_t> stamp{0};
+    };
+
+    HASH _hash;
+    EQUAL _equal;
+    std::vector<Slot> _slots;
+    std::unordered_multimap<std::size_t, std::size_t> _index;
+    std::size_t _size = 0;
+    mutable std::atomic<std::uint64_t> _clock{0};
+    mutable std::shared_mutex _mutex;
+
+    template <typename KEY_REF>
+    const Slot*
+    find_slot(const std::size_t hash, const KEY_REF& key) const
+    {
+      const auto [begin, end] = _index.equal_range(hash);
+      for (auto it = begin; it != end; ++it)
+      {
+        const Slot& slot = _slots[it->second];
+        if (_equal(*slot.key, key)) return &slot;
+      }
+      return nullptr;
+    }
+
+   public:
+    explicit LRU_Cache(const std::size_t capacity) : _slots(capacity)
+    {
+      assert(capacity > 0);
+      _index.reserve(capacity);
+    }
+
+    template <typename KEY_REF>
+    std::optional<VALUE>
+    find(const KEY_REF& key) const
+    {
+      const std::size_t hash = _hash(key);
+
+      std::shared_lock lock(_mutex);
+
+      const Slot* slot = find_slot(hash, key);
+      if (slot == nullptr) return {};
+
+      slot->stamp.store(_clock.fetch_add(1, std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+      return slot->value;
+    }
+
+    template <typename KEY_REF>
+    void
+    insert(const KEY_REF& key, const VALUE& value)
+    {
+      const std::size_t hash = _hash(key);
+
+      std::unique_lock lock(_mutex);
+
+      // another thread may have inserted it meanwhile
+      if (find_slot(hash, key) != nullptr) return;
+
+      std::size_t victim = _size;
+      if (_size < _slots.size())
+      {
+        ++_size;
+      }
+      else
+      {
+        victim = 0;
+        for (std::size_t i = 1; i < _slots.size(); ++i)
+        {
+          if (_slots[i].stamp.load(std::memory_order_relaxed) <
+              _slots[victim].stamp.load(std::memory_order_relaxed))
+          {
+            victim = i;
+          }
+        }
+        const auto [begin, end] = _index.equal_range(_slots[victim].hash);
+        for (auto it = begin; it != end; ++it)
+        {
+          if (it->second == victim)
+          {
+            _index.erase(it);
+            break;
+          }
+        }
+      }
+
+      Slot& slot = _slots[victim];
+      slot.key.emplace(key);
+      slot.value.emplace(value);
+      slot.hash = hash;
+      slot.stamp.store(_clock.fetch_add(1, std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+      _index.emplace(hash, victim);
+    }
+
+    std::size_t
+    size() const
+    {
+      std::shared_lock lock(_mutex);
+      return _size;
+    }
+
+    std::size_t
+    capacity() const
+    {
+      return _slots.size();
+    }
+  };
+
+  //////////////// Cache policies ////////////////
+  //
+  struct Cache_Last_K_Policy
+  {
+    std::size_t k    = 8;
+    double tolerance = 0;
+
+    template <typename KEY, typename VALUE>
+    using cache_type = Last_K_Cache<KEY, VALUE>;
+
+    template <typename KEY, typename VALUE>
+    cache_type<KEY, VALUE>
+    create() const
+    {
+      return {k, tolerance};
+    }
+  };
+
+  struct Cache_LRU_Policy
+  {
+    std::size_t capacity = 64;
+
+    template <typename KEY, typename VALUE>
+    using cache_type = LRU_Cache<KEY, VALUE>;
+
+    template <typename KEY, typename VALUE>
+    cache_type<KEY, VALUE>
+    create() const
+    {
+      return cache_type<KEY, VALUE>(capacity);
+    }
+  };
+
+  //////////////// Named_Std_Function_Cache ////////////////
+  //
+  // Memoizes a Named_Std_Function (or any named callable defining
+  // value_type = std::function<OUTPUT(ARGS...)>).
+  //
+  // Usage:
+  //
+  //   Named_Std_Function_Cache<Objective_Function, Cache_LRU_Policy> cache(
+  //       objective_function = Rosenbrock, Cache_LRU_Policy{128});
+  //
+  //   my_algorithm(cache.named_function(), x);
+  //
+  //   std::cout << cache.statistics();
+  //
+  // named_function() returns an ordinary NAMED_FUNCTION, hence it can
+  // be used wherever NAMED_FUNCTION is accepted. All copies share the
+  // same cache.
+  //
+  template <typename NAMED_FUNCTION, typename CACHE_POLICY,
+            typename STD_FUNCTION = typename NAMED_FUNCTION::value_type>
+  class Named_Std_Function_Cache;
+
+  template <typename NAMED_FUNCTION, typename CACHE_POLICY, typename OUTPUT, typename... ARGS>
+  class Named_Std_Function_Cache<NAMED_FUNCTION, CACHE_POLICY, std::function<OUTPUT(ARGS...)>>
+  {
+    static_assert(not std::is_void_v<OUTPUT>, "Nothing to cache");
+
+   public:
+    using named_function_type = NAMED_FUNCTION;
+    using key_type            = std::tuple<std::decay_t<ARGS>...>;
+    using output_type         = std::decay_t<OUTPUT>;
+    using cache_type = typename CACHE_POLICY::template cache_type<key_type, output_type>;
+
+   protected:
+    struct State
+    {
+      NAMED_FUNCTION f;
+      cache_type cache;
+      std::atomic<std::size_t> hits{0};
+      std::atomic<std::size_t> misses{0};
+
+      State(NAMED_FUNCTION&& f, const CACHE_POLICY& policy)
+          : f(std::move(f)), cache(policy.template create<key_type, output_type>())
+      {
+      }
+
+      OUTPUT
+      operator()(ARGS... args)
+      {
+        const auto key = std::forward_as_tuple(args...);
+
+        if (auto cached = cache.find(key); cached.has_value())
+        {
+          hits.fetch_add(1, std::memory_order_relaxed);
+          return *std::move(cached);
+        }
+
+        misses.fetch_add(1, std::memory_order_relaxed);
+
+        // computed outside any lock: concurrent misses on the same
+        // key may both evaluate f
+        output_type value = f(args...);
+        cache.insert(key, value);
+        return value;
+      }
+    };
+
+    std::shared_ptr<State> _state;
+
+   public:
+    explicit Named_Std_Function_Cache(NAMED_FUNCTION f, const CACHE_POLICY& policy = CACHE_POLICY())
+        : _state(std::make_shared<State>(std::move(f), policy))
+    {
+      assert(not _state->f.is_empty());
+    }
+
+    NAMED_FUNCTION
+    named_function() const
+    {
+      return NAMED_FUNCTION{[state = _state](ARGS... args) -> OUTPUT {
+        return (*state)(std::forward<ARGS>(args)...);
+      }};
+    }
+
+    OUTPUT
+    operator()(ARGS... args) const { return (*_state)(std::forward<ARGS>(args)...); }
+
+    Cache_Statistics
+    statistics() const
+    {
+      return {_state->hits.load(std::memory_order_relaxed),
+              _state->misses.load(std::memory_order_relaxed)};
+    }
+
+    void
+    reset_statistics()
+    {
+      _state->hits.store(0, std::memory_order_relaxed);
+      _state->misses.store(0, std::memory_order_relaxed);
+    }
+  };
+
+}  // namespace OptionalArgument
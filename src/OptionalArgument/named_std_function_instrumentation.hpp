@@ -0,0 +1,302 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "named_std_function.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Define OPTIONAL_ARGUMENT_INSTRUMENTATION=0 to compile instrumentation
+// away: instrument() then returns its argument unchanged.
+//
+#ifndef OPTIONAL_ARGUMENT_INSTRUMENTATION
+#define OPTIONAL_ARGUMENT_INSTRUMENTATION 1
+#endif
+
+namespace OptionalArgument
+{
+  //////////////// Is_Named_Std_Function ////////////////
+  //
+  template <typename T>
+  struct Is_Named_Std_Function : std::false_type
+  {
+  };
+
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  struct Is_Named_Std_Function<Named_Std_Function<TAG, OUTPUT, ARGS...>> : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Named_Std_Function_v = Is_Named_Std_Function<T>::value;
+
+  //////////////// Latency_Histogram ////////////////
+  //
+  // Log-linear histogram of latencies in nanoseconds: each power of
+  // two is split into 4 sub-buckets, hence percentiles are known up
+  // to ~25%. All counters are relaxed atomics.
+  //
+  class Latency_Histogram
+  {
+    static constexpr std::size_t sub_bucket_bits  = 2;
+    static constexpr std::size_t sub_bucket_count = std::size_t(1) << sub_bucket_bits;
+    static constexpr std::size_t bucket_count     = 64 * sub_bucket_count;
+
+    std::array<std::atomic<std::uint64_t>, bucket_count> _buckets{};
+
+    static std::size_t
+    bucket_index(std::uint64_t ns) noexcept
+    {
+      if (ns < sub_bucket_count) return static_cast<std::size_t>(ns);
+
+      std::size_t log2 = 63;
+      while (((ns >> log2) & 1) == 0) --log2;
+
+      const std::size_t sub = (ns >> (log2 - sub_bucket_bits)) & (sub_bucket_count - 1);
+      return (log2 - sub_bucket_bits + 1) * sub_bucket_count + sub;
+    }
+
+    // upper bound of the bucket
+    static std::uint64_t
+    bucket_value(std::size_t index) noexcept
+    {
+      if (index < sub_bucket_count) return index;
+
+      const std::size_t log2 = index / sub_bucket_count + sub_bucket_bits - 1;
+      const std::size_t sub  = index % sub_bucket_count;
+      return ((sub_bucket_count + sub + 1) << (log2 - sub_bucket_bits)) - 1;
+    }
+
+   public:
+    void
+    record(std::uint64_t ns) noexcept
+    {
+      _buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // p in [0,1]
+    std::uint64_t
+    percentile(double p) const noexcept
+    {
+      std::uint64_t count = 0;
+      for (const auto& bucket : _buckets) count += bucket.load(std::memory_order_relaxed);
+      if (count == 0) return 0;
+
+      const auto rank = static_cast<std::uint64_t>(p * static_cast<double>(count - 1)) + 1;
+
+      std::uint64_t cumulated = 0;
+      for (std::size_t i = 0; i < bucket_count; ++i)
+      {
+        cumulated += _buckets[i].load(std::memory_order_relaxed);
+        if (cumulated >= rank) return bucket_value(i);
+      }
+      return bucket_value(bucket_count - 1);
+    }
+
+    void
+    reset() noexcept
+    {
+      for (auto& bucket : _buckets) bucket.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  //////////////// Call_Statistics ////////////////
+  //
+  struct Call_Statistics
+  {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::atomic<std::uint64_t> max_ns{0};
+    Latency_Histogram histogram;
+
+    void
+    record(const std::uint64_t ns) noexcept
+    {
+      calls.fetch_add(1, std::memory_order_relaxed);
+      total_ns.fetch_add(ns, std::memory_order_relaxed);
+      histogram.record(ns);
+
+      std::uint64_t current_max = max_ns.load(std::memory_order_relaxed);
+      while (current_max < ns &&
+             not max_ns.compare_exchange_weak(current_max, ns, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    void
+    reset() noexcept
+    {
+      calls.store(0, std::memory_order_relaxed);
+      total_ns.store(0, std::memory_order_relaxed);
+      max_ns.store(0, std::memory_order_relaxed);
+      histogram.reset();
+    }
+  };
+
+  inline std::ostream&
+  operator<<(std::ostream& out, const Call_Statistics& to_print)
+  {
+    const auto calls    = to_print.calls.load(std::memory_order_relaxed);
+    const auto total_ns = to_print.total_ns.load(std::memory_order_relaxed);
+
+    out << "calls " << calls << " total " << total_ns << "ns mean "
+        << (calls ? total_ns / calls : 0) << "ns p50 " << to_print.histogram.percentile(0.5)
+        << "ns p90 " << to_print.histogram.percentile(0.9) << "ns p99 "
+        << to_print.histogram.percentile(0.99) << "ns max "
+        << to_print.max_ns.load(std::memory_order_relaxed) << "ns";
+    return out;
+  }
+
+  //////////////// Instrumentation registry ////////////////
+  //
+  // One Call_Statistics per tag, registered on first use so that
+  // print_instrumentation_report() can list them all.
+  //
+  class Instrumentation_Registry
+  {
+    struct Entry
+    {
+      std::string_view tag_name;
+      const Call_Statistics* statistics;
+    };
+
+    std::mutex _mutex;
+    std::vector<Entry> _entries;
+
+   public:
+    static Instrumentation_Registry&
+    instance()
+    {
+      static Instrumentation_Registry registry;
+      return registry;
+    }
+
+    void
+    add(std::string_view tag_name, const Call_Statistics* statistics)
+    {
+      std::lock_guard lock(_mutex);
+      _entries.push_back({tag_name, statistics});
+    }
+
+    void
+    print(std::ostream& out)
+    {
+      std::lock_guard lock(_mutex);
+      for (const auto& entry : _entries)
+      {
+        out << std::left << std::setw(32) << entry.tag_name << " " << *entry.statistics << "\n";
+      }
+    }
+  };
+
+  template <typename TAG>
+  Call_Statistics&
+  call_statistics()
+  {
+    static Call_Statistics statistics;
+    static const bool registered = (Instrumentation_Registry::instance().add(type_name<TAG>(),
+                                                                             &statistics),
+                                    true);
+    (void)registered;
+    return statistics;
+  }
+
+  inline std::ostream&
+  print_instrumentation_report(std::ostream& out)
+  {
+#if OPTIONAL_ARGUMENT_INSTRUMENTATION
+    Instrumentation_Registry::instance().print(out);
+#else
+    out << "instrumentation disabled (OPTIONAL_ARGUMENT_INSTRUMENTATION=0)\n";
+#endif
+    return out;
+  }
+
+  //////////////// instrument() ////////////////
+  //
+  // Returns a NAMED_FUNCTION counting calls and measuring their
+  // latency, statistics are accumulated per tag:
+  //
+  //   my_algorithm(instrument(objective_function = Rosenbrock), x);
+  //   std::cout << call_statistics<Objective_Function_Tag>();
+  //
+  template <typename TAG, typename OUTPUT, typename... ARGS>
+  Named_Std_Function<TAG, OUTPUT, ARGS...>
+  instrument(Named_Std_Function<TAG, OUTPUT, ARGS...> f)
+  {
+#if OPTIONAL_ARGUMENT_INSTRUMENTATION
+    if (f.is_empty()) return f;
+
+    return Named_Std_Function<TAG, OUTPUT, ARGS...>{
+        [f = std::move(f), &statistics = call_statistics<TAG>()](ARGS... args) -> OUTPUT {
+          struct Scope_Timer
+          {
+            Call_Statistics& statistics;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            ~Scope_Timer()
+            {
+              statistics.record(static_cast<std::uint64_t>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count()));
+            }
+          } scope_timer{statistics};
+
+          return f(std::forward<ARGS>(args)...);
+        }};
+#else
+    return f;
+#endif
+  }
+
+  //////////////// instrument_named_functions() ////////////////
+  //
+  // Instruments, in place, all the Named_Std_Function options of an
+  // Optional_Argument pack (including std::optional ones). Meant to be
+  // called by the algorithm just after optional_argument():
+  //
+  //   auto options = take_optional_argument_ref(objective_function, observer);
+  //   optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+  //   instrument_named_functions(options);
+  //
+  template <typename... OPTIONs>
+  void
+  instrument_named_functions([[maybe_unused]] Optional_Argument<OPTIONs...>& options)
+  {
+#if OPTIONAL_ARGUMENT_INSTRUMENTATION
+    [[maybe_unused]] auto dispatch = [](auto& option) {
+      using OPTION = std::decay_t<decltype(option)>;
+
+      if constexpr (Is_Optional_v<OPTION>)
+      {
+        if constexpr (Is_Named_Std_Function_v<typename OPTION::value_type>)
+        {
+          if (option.has_value()) option = instrument(std::move(*option));
+        }
+      }
+      else if constexpr (Is_Named_Std_Function_v<OPTION>)
+      {
+        option = instrument(std::move(option));
+      }
+    };
+
+    (dispatch(std::get<OPTIONs>(options)), ...);
+#endif
+  }
+
+}  // namespace OptionalArgument
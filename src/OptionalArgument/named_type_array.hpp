@@ -0,0 +1,325 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define OPTIONAL_ARGUMENT_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define OPTIONAL_ARGUMENT_RESTRICT __restrict
+#else
+#define OPTIONAL_ARGUMENT_RESTRICT
+#endif
+
+namespace OptionalArgument
+{
+  //////////////// Has_Value_Layout ////////////////
+  //
+  // Tests if NAMED (like Named_Type<TAG,double>) has exactly the
+  // layout of its value_type, hence an array of NAMED can be seen as
+  // an array of value_type (and conversely) without copy.
+  //
+  template <typename NAMED, typename = void>
+  struct Has_Value_Layout : std::false_type
+  {
+  };
+
+  template <typename NAMED>
+  struct Has_Value_Layout<NAMED, std::void_t<typename NAMED::value_type>>
+      : std::integral_constant<
+            bool, std::is_standard_layout_v<NAMED> &&
+                      std::is_standard_layout_v<typename NAMED::value_type> &&
+                      (std::is_trivially_copyable_v<NAMED> ==
+                       std::is_trivially_copyable_v<typename NAMED::value_type>) &&
+                      (sizeof(NAMED) == sizeof(typename NAMED::value_type)) &&
+                      (alignof(NAMED) == alignof(typename NAMED::value_type))>
+  {
+  };
+
+  template <typename NAMED>
+  constexpr auto Has_Value_Layout_v = Has_Value_Layout<NAMED>::value;
+
+  // The guarantees we rely on for the scalar types used in hot loops
+  //
+  static_assert(Has_Value_Layout_v<Named_Type<struct Has_Value_Layout_Check_Tag, double>>);
+  static_assert(Has_Value_Layout_v<Named_Type<struct Has_Value_Layout_Check_Tag, float>>);
+  static_assert(Has_Value_Layout_v<Named_Type<struct Has_Value_Layout_Check_Tag, int>>);
+  static_assert(
+      std::is_trivially_copyable_v<Named_Type<struct Has_Value_Layout_Check_Tag, double>>);
+
+  //////////////// Span ////////////////
+  //
+  // Minimal (pointer,size) view, T can be const
+  //
+  template <typename T>
+  class Span
+  {
+   public:
+    using value_type = std::remove_cv_t<T>;
+
+   protected:
+    T* _data;
+    std::size_t _size;
+
+   public:
+    constexpr Span() noexcept : _data(nullptr), _size(0) {}
+    constexpr Span(T* data, const std::size_t size) noexcept : _data(data), _size(size) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    constexpr Span(const Span<U>& span) noexcept : _data(span.data()), _size(span.size())
+    {
+    }
+
+    constexpr T*
+    data() const noexcept
+    {
+      return _data;
+    }
+    constexpr std::size_t
+    size() const noexcept
+    {
+      return _size;
+    }
+    constexpr T&
+    operator[](const std::size_t i) const noexcept
+    {
+      assert(i < _size);
+      return _data[i];
+    }
+    constexpr T*
+    begin() const noexcept
+    {
+      return _data;
+    }
+    constexpr T*
+    end() const noexcept
+    {
+      return _data + _size;
+    }
+  };
+
+  //////////////// Zero-copy adapters ////////////////
+  //
+  //   std::vector<Coordinate> x(n);
+  //   Span<double> raw = as_value_span(x);            // -> BLAS, SIMD kernels...
+  //   Span<Coordinate> named = as_named_span<Coordinate>(raw_vector);
+  //
+  // These are reinterpret_cast only. NAMED and value_type are layout
+  // compatible (standard layout, same size/alignment, see
+  // Has_Value_Layout), they have the same representation on all the
+  // supported compilers. That is all: the standard does not sanction
+  // accessing a value_type buffer through NAMED (no NAMED object lives
+  // there), nor the converse. We rely on it in practice, as when
+  // passing such arrays to BLAS.
+  //
+  template <typename NAMED>
+  Span<typename NAMED::value_type>
+  as_value_span(NAMED* data, const std::size_t size) noexcept
+  {
+    static_assert(Has_Value_Layout_v<NAMED>);
+    return {reinterpret_cast<typename NAMED::value_type*>(data), size};
+  }
+
+  template <typename NAMED>
+  Span<const typename NAMED::value_type>
+  as_value_span(const NAMED* data, const std::size_t size) noexcept
+  {
+    static_assert(Has_Value_Layout_v<NAMED>);
+    return {reinterpret_cast<const typename NAMED::value_type*>(data), size};
+  }
+
+  template <typename NAMED, typename ALLOCATOR>
+  Span<typename NAMED::value_type>
+  as_value_span(std::vector<NAMED, ALLOCATOR>& v) noexcept
+  {
+    return as_value_span(v.data(), v.size());
+  }
+
+  template <typename NAMED, typename ALLOCATOR>
+  Span<const typename NAMED::value_type>
+  as_value_span(const std::vector<NAMED, ALLOCATOR>& v) noexcept
+  {
+    return as_value_span(v.data(), v.size());
+  }
+
+  template <typename NAMED>
+  Span<NAMED>
+  as_named_span(typename NAMED::value_type* data, const std::size_t size) noexcept
+  {
+    static_assert(Has_Value_Layout_v<NAMED>);
+    return {reinterpret_cast<NAMED*>(data), size};
+  }
+
+  template <typename NAMED>
+  Span<const NAMED>
+  as_named_span(const typename NAMED::value_type* data, const std::size_t size) noexcept
+  {
+    static_assert(Has_Value_Layout_v<NAMED>);
+    return {reinterpret_cast<const NAMED*>(data), size};
+  }
+
+  template <typename NAMED, typename ALLOCATOR>
+  Span<NAMED>
+  as_named_span(std::vector<typename NAMED::value_type, ALLOCATOR>& v) noexcept
+  {
+    return as_named_span<NAMED>(v.data(), v.size());
+  }
+
+  template <typename NAMED, typename ALLOCATOR>
+  Span<const NAMED>
+  as_named_span(const std::vector<typename NAMED::value_type, ALLOCATOR>& v) noexcept
+  {
+    return as_named_span<NAMED>(v.data(), v.size());
+  }
+
+  //////////////// Bulk operations ////////////////
+  //
+  // Elementwise operations on named arrays, performed on the
+  // underlying value_type arrays through restrict pointers so that
+  // they are vectorized. Output must not alias inputs, except for the
+  // in-place versions. Inputs can be Span<NAMED> or Span<const NAMED>.
+  //
+  template <typename NAMED, typename IN, typename OP>
+  void
+  bulk_transform(const Span<NAMED> out, const Span<IN> in, OP op) noexcept
+  {
+    static_assert(std::is_same_v<std::remove_const_t<IN>, NAMED>);
+    using T = typename NAMED::value_type;
+
+    assert(out.size() == in.size());
+
+    T* OPTIONAL_ARGUMENT_RESTRICT out_data      = as_value_span(out.data(), out.size()).data();
+    const T* OPTIONAL_ARGUMENT_RESTRICT in_data = as_value_span(in.data(), in.size()).data();
+    const std::size_t n                         = out.size();
+
+    for (std::size_t i = 0; i < n; ++i) out_data[i] = op(in_data[i]);
+  }
+
+  template <typename NAMED, typename IN_0, typename IN_1, typename OP>
+  void
+  bulk_transform(const Span<NAMED> out, const Span<IN_0> in_0, const Span<IN_1> in_1,
+                 OP op) noexcept
+  {
+    static_assert(std::is_same_v<std::remove_const_t<IN_0>, NAMED>);
+    static_assert(std::is_same_v<std::remove_const_t<IN_1>, NAMED>);
+    using T = typename NAMED::value_type;
+
+    assert(out.size() == in_0.size());
+    assert(out.size() == in_1.size());
+
+    T* OPTIONAL_ARGUMENT_RESTRICT out_data = as_value_span(out.data(), out.size()).data();
+    const T* OPTIONAL_ARGUMENT_RESTRICT in_0_data =
+        as_value_span(in_0.data(), in_0.size()).data();
+    const T* OPTIONAL_ARGUMENT_RESTRICT in_1_data =
+        as_value_span(in_1.data(), in_1.size()).data();
+    const std::size_t n = out.size();
+
+    for (std::size_t i = 0; i < n; ++i) out_data[i] = op(in_0_data[i], in_1_data[i]);
+  }
+
+  // in place
+  template <typename NAMED, typename OP>
+  void
+  bulk_apply(const Span<NAMED> inout, OP op) noexcept
+  {
+    using T = typename NAMED::value_type;
+
+    T* OPTIONAL_ARGUMENT_RESTRICT data = as_value_span(inout.data(), inout.size()).data();
+    const std::size_t n                = inout.size();
+
+    for (std::size_t i = 0; i < n; ++i) data[i] = op(data[i]);
+  }
+
+  // y <- alpha x + y
+  template <typename IN, typename NAMED>
+  void
+  bulk_axpy(const typename NAMED::value_type alpha, const Span<IN> x, const Span<NAMED> y) noexcept
+  {
+    static_assert(std::is_same_v<std::remove_const_t<IN>, NAMED>);
+    using T = typename NAMED::value_type;
+
+    assert(x.size() == y.size());
+
+    const T* OPTIONAL_ARGUMENT_RESTRICT x_data = as_value_span(x.data(), x.size()).data();
+    T* OPTIONAL_ARGUMENT_RESTRICT y_data       = as_value_span(y.data(), y.size()).data();
+    const std::size_t n                        = x.size();
+
+    for (std::size_t i = 0; i < n; ++i) y_data[i] += alpha * x_data[i];
+  }
+
+  // sum_i x_i y_i
+  //
+  // 4 partial sums: breaks the dependency chain and allows
+  // vectorization without -ffast-math (summation order is fixed)
+  //
+  template <typename IN_0, typename IN_1>
+  typename IN_0::value_type
+  bulk_dot(const Span<IN_0> x, const Span<IN_1> y) noexcept
+  {
+    static_assert(std::is_same_v<std::remove_const_t<IN_0>, std::remove_const_t<IN_1>>);
+    using T = typename IN_0::value_type;
+
+    assert(x.size() == y.size());
+
+    const T* x_data     = as_value_span(x.data(), x.size()).data();
+    const T* y_data     = as_value_span(y.data(), y.size()).data();
+    const std::size_t n = x.size();
+
+    const std::size_t n_4 = n - n % 4;
+
+    T sum[4] = {T(), T(), T(), T()};
+    for (std::size_t i = 0; i < n_4; i += 4)
+    {
+      for (std::size_t k = 0; k < 4; ++k) sum[k] += x_data[i + k] * y_data[i + k];
+    }
+    for (std::size_t i = n_4; i < n; ++i) sum[0] += x_data[i] * y_data[i];
+
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+  }
+
+  template <typename IN>
+  typename IN::value_type
+  bulk_sum(const Span<IN> x) noexcept
+  {
+    using T = typename IN::value_type;
+
+    const T* x_data     = as_value_span(x.data(), x.size()).data();
+    const std::size_t n = x.size();
+
+    const std::size_t n_4 = n - n % 4;
+
+    T sum[4] = {T(), T(), T(), T()};
+    for (std::size_t i = 0; i < n_4; i += 4)
+    {
+      for (std::size_t k = 0; k < 4; ++k) sum[k] += x_data[i + k];
+    }
+    for (std::size_t i = n_4; i < n; ++i) sum[0] += x_data[i];
+
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+  }
+
+  //////////////// Span helpers for std::vector<NAMED> ////////////////
+  //
+  template <typename T, typename ALLOCATOR>
+  Span<T>
+  make_span(std::vector<T, ALLOCATOR>& v) noexcept
+  {
+    return {v.data(), v.size()};
+  }
+
+  template <typename T, typename ALLOCATOR>
+  Span<const T>
+  make_span(const std::vector<T, ALLOCATOR>& v) noexcept
+  {
+    return {v.data(), v.size()};
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,249 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "named_type_array.hpp"
+#include "optional_argument_core.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Counter_Generator ////////////////
+  //
+  // Counter based generator: the i-th number of a (seed, stream) is
+  // a hash of i (SplitMix64 finalizer). No state carried from one
+  // number to the next: a block is a vectorizable loop, and any part
+  // of the sequence is computed directly, whatever the thread that
+  // computes it.
+  //
+  class Counter_Generator
+  {
+   protected:
+    std::uint64_t _key;
+
+   public:
+    static constexpr std::uint64_t
+    mix(std::uint64_t z) noexcept
+    {
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+    constexpr Counter_Generator(const std::uint64_t seed, const std::uint64_t stream) noexcept
+        : _key(mix(mix(seed) ^ (stream * 0x9e3779b97f4a7c15ULL)))
+    {
+    }
+
+    constexpr std::uint64_t
+    operator()(const std::uint64_t counter) const noexcept
+    {
+      return mix(_key + counter * 0x9e3779b97f4a7c15ULL);
+    }
+
+    // uniform in (0,1], 53 bits
+    //
+    static constexpr double
+    to_uniform(const std::uint64_t bits) noexcept
+    {
+      return static_cast<double>((bits >> 11) + 1) * 0x1.0p-53;
+    }
+  };
+
+  //////////////// normal_sample() ////////////////
+  //
+  // Fills a caller buffer with N(0,1) samples (|N(0,1)| if
+  // truncated):
+  //
+  //   std::vector<double> sample(1 << 24);
+  //   normal_sample(sample, truncated_sample, sample_seed = 42, sample_threads = 8);
+  //
+  // Options:
+  // - sample_size: number of samples (default: buffer size)
+  // - truncated_sample: flag
+  // - sample_seed, sample_stream: independent sequences for distinct
+  //   (seed, stream), e.g. one stream per Monte-Carlo replication.
+  //   To inject an engine: sample_seed = engine()
+  // - sample_threads: worker threads (default 1, 0 = hardware
+  //   concurrency)
+  // - sample_block_size: sample pairs per generator block
+  //
+  // The i-th sample only depends on (seed, stream, i): the result is
+  // reproducible and independent of the thread and block counts.
+  // The truncation is resolved once per call.
+  //
+  using Sample_Size          = Named_Type<struct Sample_Size_Tag, std::size_t>;
+  constexpr auto sample_size = typename Sample_Size::argument_syntactic_sugar();
+
+  using Truncated_Sample          = Named_Type<struct Truncated_Sample_Tag>;
+  constexpr auto truncated_sample = Truncated_Sample();
+
+  using Sample_Seed          = Named_Type<struct Sample_Seed_Tag, std::uint64_t>;
+  constexpr auto sample_seed = typename Sample_Seed::argument_syntactic_sugar();
+
+  using Sample_Stream          = Named_Type<struct Sample_Stream_Tag, std::uint64_t>;
+  constexpr auto sample_stream = typename Sample_Stream::argument_syntactic_sugar();
+
+  using Sample_Threads          = Named_Type<struct Sample_Threads_Tag, std::size_t>;
+  constexpr auto sample_threads = typename Sample_Threads::argument_syntactic_sugar();
+
+  using Sample_Block_Size          = Named_Type<struct Sample_Block_Size_Tag, std::size_t>;
+  constexpr auto sample_block_size = typename Sample_Block_Size::argument_syntactic_sugar();
+
+  // Samples [begin, end) of the sequence, begin even
+  //
+  // Marsaglia polar method on sample pairs: the first attempt of all
+  // the pairs of a block is a vectorizable pass, the rejected ones
+  // (1 - pi/4 ~ 21%) are redrawn by a scalar fix-up pass.
+  //
+  template <bool TRUNCATED, typename T>
+  void
+  normal_sample_range(const Counter_Generator& generator, T* const sample,
+                      const std::size_t begin, const std::size_t end,
+                      const std::size_t block_size)
+  {
+    static_assert(std::is_floating_point_v<T>);
+    assert(begin % 2 == 0);
+    assert(block_size > 0);
+
+    std::vector<double> u(block_size), v(block_size), s(block_size);
+
+    // point of the unit disk: (u, v), s = u^2 + v^2
+    auto draw = [](const std::uint64_t bits_u, const std::uint64_t bits_v, double& u, double& v) {
+      u = 2 * Counter_Generator::to_uniform(bits_u) - 1;
+      v = 2 * Counter_Generator::to_uniform(bits_v) - 1;
+      return u * u + v * v;
+    };
+
+    // pairs [2 j, 2 j + 1]
+    const std::size_t pair_end = (end + 1) / 2;
+
+    for (std::size_t block_begin = begin / 2; block_begin < pair_end; block_begin += block_size)
+    {
+      const std::size_t n = std::min(block_size, pair_end - block_begin);
+
+      // vectorizable: no dependency between iterations
+      for (std::size_t k = 0; k < n; ++k)
+      {
+        const std::uint64_t counter = 2 * (block_begin + k);
+
+        s[k] = draw(generator(counter), generator(counter + 1), u[k], v[k]);
+      }
+
+      for (std::size_t k = 0; k < n; ++k)
+      {
+        const std::uint64_t counter = 2 * (block_begin + k);
+
+        for (std::uint64_t attempt = 1; s[k] >= 1 || s[k] == 0; ++attempt)
+        {
+          const std::uint64_t bits = Counter_Generator::mix(generator(counter) + attempt);
+          s[k] = draw(bits, Counter_Generator::mix(bits), u[k], v[k]);
+        }
+      }
+
+      for (std::size_t k = 0; k < n; ++k)
+      {
+        const double factor = std::sqrt(-2 * std::log(s[k]) / s[k]);
+
+        u[k] *= factor;
+        v[k] *= factor;
+
+        if constexpr (TRUNCATED)
+        {
+          u[k] = std::abs(u[k]);
+          v[k] = std::abs(v[k]);
+        }
+      }
+
+      T* const out                 = sample + 2 * block_begin;
+      const std::size_t full_pairs = std::min(n, (end - 2 * block_begin) / 2);
+      for (std::size_t k = 0; k < full_pairs; ++k)
+      {
+        out[2 * k]     = static_cast<T>(u[k]);
+        out[2 * k + 1] = static_cast<T>(v[k]);
+      }
+      if (full_pairs < n) out[2 * full_pairs] = static_cast<T>(u[full_pairs]);  // odd end
+    }
+  }
+
+  template <typename T, typename... USER_OPTIONS>
+  void
+  normal_sample(const Span<T> sample, USER_OPTIONS&&... user_options)
+  {
+    Sample_Size size{sample.size()};
+    std::optional<Truncated_Sample> truncated;
+    Sample_Seed seed{0};
+    Sample_Stream stream{0};
+    Sample_Threads n_threads{1};
+    Sample_Block_Size block_size{512};
+
+    auto options =
+        take_optional_argument_ref(size, truncated, seed, stream, n_threads, block_size);
+    optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+    assert(size.value() <= sample.size());
+    assert(block_size.value() > 0);
+
+    const Counter_Generator generator(seed.value(), stream.value());
+
+    auto fill = [&](const std::size_t begin, const std::size_t end) {
+      if (truncated)
+      {
+        normal_sample_range<true>(generator, sample.data(), begin, end, block_size.value());
+      }
+      else
+      {
+        normal_sample_range<false>(generator, sample.data(), begin, end, block_size.value());
+      }
+    };
+
+    std::size_t threads = n_threads.value();
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // even chunks, at least one block per thread
+    const std::size_t n_pairs = (size.value() + 1) / 2;
+    threads                   = std::max<std::size_t>(
+        1, std::min(threads, (n_pairs + block_size.value() - 1) / block_size.value()));
+
+    if (threads == 1)
+    {
+      fill(0, size.value());
+      return;
+    }
+
+    const std::size_t pairs_per_thread = (n_pairs + threads - 1) / threads;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t)
+    {
+      const std::size_t begin = std::min(size.value(), 2 * t * pairs_per_thread);
+      const std::size_t end   = std::min(size.value(), 2 * (t + 1) * pairs_per_thread);
+      if (begin < end) workers.emplace_back(fill, begin, end);
+    }
+    fill(0, std::min(size.value(), 2 * pairs_per_thread));
+
+    for (auto& worker : workers) worker.join();
+  }
+
+  template <typename T, typename ALLOCATOR, typename... USER_OPTIONS>
+  void
+  normal_sample(std::vector<T, ALLOCATOR>& sample, USER_OPTIONS&&... user_options)
+  {
+    normal_sample(Span<T>(sample.data(), sample.size()),
+                  std::forward<USER_OPTIONS>(user_options)...);
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,392 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "option_hash.hpp"
+#include "optional_argument_core.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Tuning ranges ////////////////
+  //
+  // A tuned option is a coordinate u in [0,1], decoded into an option
+  // value:
+  //
+  //   tuning_range<Max_Iterations>(10, 1000)           // linear
+  //   tuning_log_range<Absolute_Precision>(1e-12, 1e-3) // log scale
+  //   tuning_choices<Block_Size>({16, 32, 64, 128})
+  //
+  // Integral values are rounded.
+  //
+  template <typename OPTION>
+  class Tuning_Range
+  {
+   public:
+    using option_type = OPTION;
+    using value_type  = typename OPTION::value_type;
+
+    static_assert(std::is_arithmetic_v<value_type>);
+
+   protected:
+    double _lower, _upper;
+    bool _log_scale;
+
+   public:
+    Tuning_Range(const value_type lower, const value_type upper, const bool log_scale = false)
+        : _lower(static_cast<double>(lower)), _upper(static_cast<double>(upper)),
+          _log_scale(log_scale)
+    {
+      assert(lower <= upper);
+      assert(not log_scale || lower > 0);
+    }
+
+    option_type
+    decode(const double u) const
+    {
+      const double x = _log_scale ? std::exp(std::log(_lower) + u * std::log(_upper / _lower))
+                                  : _lower + u * (_upper - _lower);
+
+      if constexpr (std::is_integral_v<value_type>)
+      {
+        return option_type{static_cast<value_type>(std::clamp(std::round(x), _lower, _upper))};
+      }
+      else
+      {
+        return option_type{static_cast<value_type>(std::clamp(x, _lower, _upper))};
+      }
+    }
+  };
+
+  template <typename OPTION>
+  class Tuning_Choices
+  {
+   public:
+    using option_type = OPTION;
+    using value_type  = typename OPTION::value_type;
+
+   protected:
+    std::vector<value_type> _choices;
+
+   public:
+    explicit Tuning_Choices(std::vector<value_type> choices) : _choices(std::move(choices))
+    {
+      assert(not _choices.empty());
+    }
+
+    option_type
+    decode(const double u) const
+    {
+      const auto i = static_cast<std::size_t>(u * static_cast<double>(_choices.size()));
+      return option_type{_choices[std::min(i, _choices.size() - 1)]};
+    }
+  };
+
+  template <typename OPTION>
+  Tuning_Range<OPTION>
+  tuning_range(const typename OPTION::value_type lower, const typename OPTION::value_type upper)
+  {
+    return {lower, upper, false};
+  }
+
+  template <typename OPTION>
+  Tuning_Range<OPTION>
+  tuning_log_range(const typename OPTION::value_type lower, const typename OPTION::value_type upper)
+  {
+    return {lower, upper, true};
+  }
+
+  template <typename OPTION>
+  Tuning_Choices<OPTION>
+  tuning_choices(std::vector<typename OPTION::value_type> choices)
+  {
+    return Tuning_Choices<OPTION>(std::move(choices));
+  }
+
+  //////////////// benchmark_cost() ////////////////
+  //
+  // Runtime cost: minimum wall time (seconds) over repetitions of
+  // run(candidate)
+  //
+  //   autotune(benchmark_cost([&](const auto& candidate) { my_algorithm(x, candidate); }),
+  //            ranges...);
+  //
+  template <typename RUN>
+  auto
+  benchmark_cost(RUN run, const std::size_t repetitions = 3)
+  {
+    assert(repetitions > 0);
+
+    return [run = std::move(run), repetitions](const auto& candidate) {
+      double best = std::numeric_limits<double>::max();
+      for (std::size_t i = 0; i < repetitions; ++i)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        run(candidate);
+        const auto stop = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+      }
+      return best;
+    };
+  }
+
+  //////////////// autotune() ////////////////
+  //
+  // Budgeted search of the option values minimizing cost(candidate),
+  // candidate being an Optional_Argument pack of the tuned options
+  // (usable as a user option):
+  //
+  //   auto result = autotune(
+  //       [&](const auto& candidate) { return my_algorithm(x, candidate).iterations; },
+  //       std::make_tuple(tuning_range<Omega>(1., 2.), tuning_range<Max_Iterations>(10, 100)),
+  //       tuning_budget = 200);
+  //
+  //   my_algorithm(x, result.best);
+  //
+  // Strategy: random sampling (tuning_random_fraction of the budget),
+  // then coordinate pattern search from the best point (the step is
+  // halved when no neighbor improves, the search restarts from a
+  // random point when the step vanishes). Every candidate counts
+  // against the budget, already evaluated candidates are not
+  // evaluated again. Throws std::invalid_argument for a zero budget or
+  // a random fraction outside [0,1].
+  //
+  using Tuning_Budget          = Named_Type<struct Tuning_Budget_Tag, std::size_t>;
+  constexpr auto tuning_budget = typename Tuning_Budget::argument_syntactic_sugar();
+
+  using Tuning_Random_Fraction          = Named_Type<struct Tuning_Random_Fraction_Tag, double>;
+  constexpr auto tuning_random_fraction =
+      typename Tuning_Random_Fraction::argument_syntactic_sugar();
+
+  using Tuning_Seed          = Named_Type<struct Tuning_Seed_Tag, std::uint64_t>;
+  constexpr auto tuning_seed = typename Tuning_Seed::argument_syntactic_sugar();
+
+  template <typename PACK, typename RANGES, typename POINT, std::size_t... I>
+  PACK
+  decode_tuning_point(const RANGES& ranges, const POINT& u, std::index_sequence<I...>)
+  {
+    return PACK(std::get<I>(ranges).decode(u[I])...);
+  }
+
+  template <typename PACK>
+  struct Autotune_Result
+  {
+    PACK best;
+    double best_cost;
+    std::size_t evaluations;  // distinct candidates evaluated
+  };
+
+  template <typename COST, typename... RANGEs, typename... USER_OPTIONS>
+  Autotune_Result<Optional_Argument<typename RANGEs::option_type...>>
+  autotune(COST&& cost, const std::tuple<RANGEs...>& ranges, USER_OPTIONS&&... user_options)
+  {
+    using Pack  = Optional_Argument<typename RANGEs::option_type...>;
+    using Point = std::array<double, sizeof...(RANGEs)>;
+
+    static_assert(sizeof...(RANGEs) > 0);
+
+    Tuning_Budget budget{64};
+    Tuning_Random_Fraction random_fraction{0.5};
+    Tuning_Seed seed{0};
+
+    auto options = take_optional_argument_ref(budget, random_fraction, seed);
+    optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+    if (budget.value() == 0)
+    {
+      throw std::invalid_argument("autotune: tuning_budget must be positive");
+    }
+    if (not(random_fraction.value() >= 0 && random_fraction.value() <= 1))
+    {
+      throw std::invalid_argument("autotune: tuning_random_fraction must be in [0,1]");
+    }
+
+    std::mt19937_64 engine(seed.value());
+    std::uniform_real_distribution<double> uniform(0, 1);
+
+    auto random_point = [&]() {
+      Point u;
+      for (auto& u_i : u) u_i = uniform(engine);
+      return u;
+    };
+
+    auto decode = [&](const Point& u) {
+      return decode_tuning_point<Pack>(ranges, u, std::index_sequence_for<RANGEs...>());
+    };
+
+    std::unordered_map<Pack, double> evaluated;
+    std::optional<Autotune_Result<Pack>> result;
+    Point best_u{};
+    std::size_t attempts = 0;
+
+    // returns true if u improves the best cost
+    auto try_point = [&](const Point& u) {
+      ++attempts;
+
+      Pack candidate    = decode(u);
+      auto [it, is_new] = evaluated.try_emplace(candidate, 0);
+      if (not is_new) return false;
+
+      it->second = cost(std::as_const(candidate));
+
+      if (result && not(it->second < result->best_cost)) return false;
+
+      result = Autotune_Result<Pack>{std::move(candidate), it->second, 0};
+      best_u = u;
+      return true;
+    };
+
+    const std::size_t n_random = std::max<std::size_t>(
+        1, static_cast<std::size_t>(std::round(random_fraction.value() * budget.value())));
+
+    while (attempts < std::min(n_random, budget.value())) try_point(random_point());
+
+    constexpr double initial_step = 0.25, min_step = 1e-3;
+    double step  = initial_step;
+    Point center = best_u;
+
+    while (attempts < budget.value())
+    {
+      bool improved = false;
+      for (std::size_t d = 0; d < center.size() && attempts < budget.value(); ++d)
+      {
+        for (const double direction : {-1., 1.})
+        {
+          if (attempts == budget.value()) break;
+
+          Point u = center;
+          u[d]    = std::clamp(u[d] + direction * step, 0., 1.);
+          if (try_point(u))
+          {
+            center   = u;
+            improved = true;
+          }
+        }
+      }
+
+      if (not improved) step /= 2;
+      if (step < min_step)
+      {
+        step   = initial_step;
+        center = random_point();
+      }
+    }
+
+    result->evaluations = evaluated.size();
+    return *result;
+  }
+
+  //////////////// Option presets ////////////////
+  //
+  // Text format, one "tag value" line per present option:
+  //
+  //   Max_Iterations_Tag 40
+  //   Omega_Tag 1.7236842105263157
+  //
+  // save_option_preset(file, result.best);
+  //
+  // and later:
+  //
+  //   const auto preset = load_option_preset<Optional_Argument<Omega, Max_Iterations>>(file);
+  //   my_algorithm(x, preset);  // missing options keep their default
+  //
+  template <typename... OPTIONs>
+  void
+  save_option_preset(std::ostream& out, const Optional_Argument<OPTIONs...>& options)
+  {
+    const auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+    [[maybe_unused]] auto save = [&](const auto& option) {
+      using OPTION = std::decay_t<decltype(option)>;
+
+      if constexpr (Is_Optional_v<OPTION>)
+      {
+        if (option.has_value())
+        {
+          out << Option_Name<typename OPTION::value_type>::value << " " << option->value()
+              << "\n";
+        }
+      }
+      else
+      {
+        out << Option_Name<OPTION>::value << " " << option.value() << "\n";
+      }
+    };
+    (save(std::get<OPTIONs>(options)), ...);
+
+    out.precision(precision);
+  }
+
+  // Returns Optional_Argument<std::optional<OPTIONs>...>, the options
+  // missing in the preset are empty. Throws std::runtime_error on
+  // unknown tag or unreadable value.
+  //
+  template <typename PACK>
+  struct Option_Preset_Loader;
+
+  template <typename... OPTIONs>
+  struct Option_Preset_Loader<Optional_Argument<OPTIONs...>>
+  {
+    using preset_type = Optional_Argument<std::optional<Option_Decay_t<OPTIONs>>...>;
+
+    static preset_type
+    load(std::istream& in)
+    {
+      preset_type preset;
+
+      std::string tag;
+      while (in >> tag)
+      {
+        bool found = false;
+
+        [[maybe_unused]] auto load_option = [&](auto& option) {
+          using OPTION = typename std::decay_t<decltype(option)>::value_type;
+
+          if (found || tag != Option_Name<OPTION>::value) return;
+
+          typename OPTION::value_type value{};
+          if (not(in >> value)) throw std::runtime_error("option preset: bad value for " + tag);
+
+          option.emplace(std::move(value));
+          found = true;
+        };
+        std::apply([&](auto&... option) { (load_option(option), ...); },
+                   static_cast<typename preset_type::tuple_type&>(preset));
+
+        if (not found) throw std::runtime_error("option preset: unknown option " + tag);
+      }
+
+      return preset;
+    }
+  };
+
+  template <typename PACK>
+  typename Option_Preset_Loader<PACK>::preset_type
+  load_option_preset(std::istream& in)
+  {
+    return Option_Preset_Loader<PACK>::load(in);
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,676 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_iostream.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OPTIONAL_ARGUMENT_HAS_MMAP 1
+#else
+#define OPTIONAL_ARGUMENT_HAS_MMAP 0
+#endif
+
+namespace OptionalArgument
+{
+  //////////////// Is_Binary_Loggable ////////////////
+  //
+  // Options stored as raw bytes: flags and options with an arithmetic
+  // or enum payload. The others (std::vector, std::function, but also
+  // pointers, std::string_view or Span, which would dangle once decoded
+  // offline) are only flagged as given (Option_Record::unencoded()),
+  // decode_options() refuses to replay such a record.
+  //
+  // Options with another self-contained trivially copyable payload
+  // can opt in:
+  //
+  //   using Box = Named_Type<struct Box_Tag, std::array<double, 4>>;
+  //
+  //   namespace OptionalArgument
+  //   {
+  //     template <>
+  //     struct Is_Binary_Loggable<Box> : std::true_type
+  //     {
+  //     };
+  //   }
+  //
+  template <typename T>
+  constexpr bool Is_Raw_Bytes_Storable_v =
+      std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+
+  template <typename T, typename = void>
+  struct Is_Binary_Loggable
+      : std::integral_constant<bool, std::is_empty_v<T> && Is_Raw_Bytes_Storable_v<T>>
+  {
+  };
+
+  template <typename T>
+  struct Is_Binary_Loggable<T, std::void_t<typename T::value_type>>
+      : std::integral_constant<bool, (std::is_arithmetic_v<typename T::value_type> ||
+                                      std::is_enum_v<typename T::value_type>) &&
+                                         Is_Raw_Bytes_Storable_v<T>>
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Binary_Loggable_v = Is_Binary_Loggable<T>::value;
+
+  //////////////// Schema ids ////////////////
+  //
+  // Computed at compile time from the tag names and the payload
+  // sizes: a decoder refuses a record written with another pack
+  // definition.
+  //
+  constexpr std::uint64_t
+  fnv1a_hash(const std::string_view s, std::uint64_t hash = 14695981039346656037ull)
+  {
+    for (const char c : s)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  template <typename OPTION>
+  constexpr std::uint64_t
+  option_schema_id()
+  {
+    std::uint64_t id = fnv1a_hash(Option_Name<OPTION>::value);
+    id ^= Is_Binary_Loggable_v<OPTION> ? sizeof(OPTION) : ~std::uint64_t(0);
+    return id * 1099511628211ull;
+  }
+
+  template <typename PACK>
+  struct Option_Pack_Schema;
+
+  template <typename... OPTIONs>
+  struct Option_Pack_Schema<Optional_Argument<OPTIONs...>>
+  {
+    static_assert(sizeof...(OPTIONs) <= 64, "presence bitmask is 64 bits");
+
+    static constexpr std::uint64_t
+    compute_id()
+    {
+      std::uint64_t id = fnv1a_hash("Optional_Argument");
+      ((id = (id ^ option_schema_id<Option_Decay_t<OPTIONs>>()) * 1099511628211ull), ...);
+      return id;
+    }
+
+    static constexpr std::uint64_t id = compute_id();
+
+    static constexpr std::size_t max_payload_size =
+        ((Is_Binary_Loggable_v<Option_Decay_t<OPTIONs>> ? sizeof(Option_Decay_t<OPTIONs>) : 0) +
+         ... + 0);
+  };
+
+  // Decoded packs store all options as std::optional, this is what
+  // optional_argument() accepts as a user option.
+  //
+  template <typename PACK>
+  struct Decoded_Options;
+
+  template <typename... OPTIONs>
+  struct Decoded_Options<Optional_Argument<OPTIONs...>>
+  {
+    using type = Optional_Argument<std::optional<Option_Decay_t<OPTIONs>>...>;
+  };
+
+  template <typename PACK>
+  using Decoded_Options_t = typename Decoded_Options<std::remove_cv_t<PACK>>::type;
+
+  //////////////// Record format ////////////////
+  //
+  // [Option_Record_Header][payloads of present loggable options, in
+  // pack order, unaligned][padding to 8 bytes]
+  //
+  struct Option_Record_Header
+  {
+    std::uint64_t schema_id;
+    std::uint64_t presence;   // bit i: option i is stored
+    std::uint64_t unencoded;  // bit i: option i is given but not loggable
+    std::uint32_t size;       // of the whole record, padding included
+    std::uint32_t committed;  // option_record_committed once fully written
+  };
+
+  constexpr std::uint32_t option_record_committed = 0x4f4b4f4b;  // "KOKO"
+
+  // Written last by encode_options(): a record interrupted before
+  // has not this marker
+  //
+  constexpr std::size_t option_record_committed_offset = offsetof(Option_Record_Header, committed);
+
+  constexpr std::size_t option_record_alignment = 8;
+
+  constexpr std::size_t
+  option_record_padded_size(const std::size_t size)
+  {
+    return (size + option_record_alignment - 1) & ~(option_record_alignment - 1);
+  }
+
+  template <typename PACK>
+  constexpr std::size_t max_option_record_size = option_record_padded_size(
+      sizeof(Option_Record_Header) + Option_Pack_Schema<std::remove_cv_t<PACK>>::max_payload_size);
+
+  // T, T&, std::optional<T>, std::optional<T>& -> const T* or nullptr
+  //
+  template <typename T>
+  const T*
+  present_option(const T& option)
+  {
+    return &option;
+  }
+
+  template <typename T>
+  const T*
+  present_option(const std::optional<T>& option)
+  {
+    return option.has_value() ? &*option : nullptr;
+  }
+
+  // f(i, p) for each present loggable option, i its position in the
+  // pack, p a pointer to it
+  //
+  template <typename... OPTIONs, typename F>
+  void
+  for_each_loggable_option(const Optional_Argument<OPTIONs...>& options, F&& f)
+  {
+    std::size_t i = 0;
+
+    [[maybe_unused]] auto visit = [&](const auto& option) {
+      using OPTION = std::remove_const_t<std::remove_pointer_t<decltype(present_option(option))>>;
+
+      if constexpr (Is_Binary_Loggable_v<OPTION>)
+      {
+        static_assert(Is_Raw_Bytes_Storable_v<OPTION>,
+                      "Is_Binary_Loggable: not storable as raw bytes");
+
+        if (const OPTION* p = present_option(option)) f(i, p);
+      }
+      ++i;
+    };
+    (visit(std::get<OPTIONs>(options)), ...);
+  }
+
+  // bit i: option i is present but not loggable
+  //
+  template <typename... OPTIONs>
+  std::uint64_t
+  unencoded_options(const Optional_Argument<OPTIONs...>& options) noexcept
+  {
+    std::uint64_t unencoded = 0;
+    std::size_t i           = 0;
+
+    [[maybe_unused]] auto visit = [&](const auto& option) {
+      using OPTION = std::remove_const_t<std::remove_pointer_t<decltype(present_option(option))>>;
+
+      if constexpr (not Is_Binary_Loggable_v<OPTION>)
+      {
+        if (present_option(option)) unencoded |= std::uint64_t(1) << i;
+      }
+      ++i;
+    };
+    (visit(std::get<OPTIONs>(options)), ...);
+
+    return unencoded;
+  }
+
+  //////////////// encode_options() ////////////////
+  //
+  // encode_options() writes the record into buffer (at least
+  // encoded_options_size() bytes, max_option_record_size<PACK> is a
+  // compile-time bound) and returns its size. No allocation.
+  //
+  template <typename... OPTIONs>
+  std::size_t
+  encoded_options_size(const Optional_Argument<OPTIONs...>& options) noexcept
+  {
+    std::size_t size = sizeof(Option_Record_Header);
+
+    for_each_loggable_option(options, [&](std::size_t, const auto* p) { size += sizeof(*p); });
+
+    return option_record_padded_size(size);
+  }
+
+  template <typename... OPTIONs>
+  std::size_t
+  encode_options(const Optional_Argument<OPTIONs...>& options, std::byte* const buffer) noexcept
+  {
+    using Schema = Option_Pack_Schema<Optional_Argument<OPTIONs...>>;
+
+    std::uint64_t presence = 0;
+    std::size_t offset     = sizeof(Option_Record_Header);
+
+    for_each_loggable_option(options, [&](const std::size_t i, const auto* p) {
+      std::memcpy(buffer + offset, p, sizeof(*p));
+      offset += sizeof(*p);
+      presence |= std::uint64_t(1) << i;
+    });
+
+    const std::size_t size = option_record_padded_size(offset);
+    std::memset(buffer + offset, 0, size - offset);
+
+    const Option_Record_Header header{Schema::id, presence, unencoded_options(options),
+                                      static_cast<std::uint32_t>(size), 0};
+    std::memcpy(buffer, &header, sizeof(header));
+    std::memcpy(buffer + option_record_committed_offset, &option_record_committed,
+                sizeof(option_record_committed));
+
+    return size;
+  }
+
+  //////////////// Option_Record ////////////////
+  //
+  // A record read back from a buffer or a log
+  //
+  class Option_Record
+  {
+   protected:
+    const std::byte* _data;
+    Option_Record_Header _header;
+
+   public:
+    explicit Option_Record(const std::byte* data) : _data(data)
+    {
+      std::memcpy(&_header, data, sizeof(_header));
+    }
+
+    std::uint64_t
+    schema_id() const
+    {
+      return _header.schema_id;
+    }
+    std::uint64_t
+    presence() const
+    {
+      return _header.presence;
+    }
+    std::uint64_t
+    unencoded() const
+    {
+      return _header.unencoded;
+    }
+    std::size_t
+    size() const
+    {
+      return _header.size;
+    }
+    bool
+    is_committed() const
+    {
+      return _header.committed == option_record_committed;
+    }
+    const std::byte*
+    data() const
+    {
+      return _data;
+    }
+
+    template <typename PACK>
+    bool
+    has_schema() const
+    {
+      return schema_id() == Option_Pack_Schema<std::remove_cv_t<PACK>>::id;
+    }
+  };
+
+  //////////////// decode_options() ////////////////
+  //
+  // PACK is the encoded Optional_Argument type (references and
+  // std::optional are ignored), throws std::runtime_error if the
+  // record has another schema, or if it was given a non loggable
+  // option: replaying without it would silently use the default.
+  //
+  //   auto stored = decode_options<decltype(options)>(record);
+  //   optional_argument(options, stored);  // replays the run
+  //
+  // decode_stored_options() only checks the schema and leaves the
+  // unencoded options absent.
+  //
+  template <typename PACK>
+  Decoded_Options_t<PACK>
+  decode_stored_options(const Option_Record& record)
+  {
+    if (not record.has_schema<PACK>())
+    {
+      throw std::runtime_error("decode_options: schema id mismatch");
+    }
+
+    Decoded_Options_t<PACK> decoded;
+    std::size_t offset = sizeof(Option_Record_Header);
+    std::size_t i      = 0;
+
+    [[maybe_unused]] auto decode = [&](auto& slot) {
+      using OPTION = typename std::decay_t<decltype(slot)>::value_type;
+
+      if constexpr (Is_Binary_Loggable_v<OPTION>)
+      {
+        if (record.presence() & (std::uint64_t(1) << i))
+        {
+          OPTION option;
+          std::memcpy(static_cast<void*>(&option), record.data() + offset, sizeof(OPTION));
+          offset += sizeof(OPTION);
+          slot = std::move(option);
+        }
+      }
+      ++i;
+    };
+    std::apply([&](auto&... slots) { (decode(slots), ...); },
+               static_cast<typename Decoded_Options_t<PACK>::tuple_type&>(decoded));
+
+    return decoded;
+  }
+
+  template <typename PACK>
+  Decoded_Options_t<PACK>
+  decode_options(const Option_Record& record)
+  {
+    auto decoded = decode_stored_options<PACK>(record);
+
+    if (record.unencoded() != 0)
+    {
+      throw std::runtime_error("decode_options: record has given but not encoded options");
+    }
+    return decoded;
+  }
+
+  //////////////// Option_Log ////////////////
+  //
+  // Append-only sequence of records in a caller provided memory region
+  // (by example a memory-mapped file, see Mapped_Option_Log). append()
+  // does not allocate and is lock-free, concurrent appends are
+  // allowed. Read the log once the writers are done.
+  //
+  // A writer interrupted after its reservation (by example a killed
+  // process) leaves an incomplete record: skipped by the readers if
+  // its size was written, otherwise the rest of the log is unreadable.
+  // Both are reported by for_each_record().
+  //
+  struct Option_Log_Scan
+  {
+    std::size_t records            = 0;  // complete records
+    std::size_t incomplete_records = 0;  // skipped
+    std::size_t unreadable_bytes   = 0;  // after a record without size
+  };
+
+  class Option_Log
+  {
+   public:
+    static constexpr std::uint64_t magic = 0x4f5054415247'4c47;  // "OPTARGLG"
+
+   protected:
+    struct Log_Header
+    {
+      std::uint64_t magic;
+      std::uint64_t capacity;
+      std::atomic<std::uint64_t> end;
+      std::uint64_t reserved;
+    };
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    Log_Header* _header;
+
+    std::byte*
+    begin_of_records() const
+    {
+      return reinterpret_cast<std::byte*>(_header) + sizeof(Log_Header);
+    }
+
+   public:
+    // region must be 8 bytes aligned. If it already contains a log
+    // (same magic) new records are appended to the existing ones.
+    //
+    Option_Log(void* const region, const std::size_t region_size)
+        : _header(static_cast<Log_Header*>(region))
+    {
+      if (region_size < sizeof(Log_Header))
+      {
+        throw std::length_error("Option_Log: region too small");
+      }
+      if (_header->magic != magic)
+      {
+        new (_header) Log_Header{magic, region_size - sizeof(Log_Header), {0}, 0};
+        std::memset(begin_of_records(), 0, _header->capacity);
+      }
+      else if (_header->capacity > region_size - sizeof(Log_Header))
+      {
+        throw std::runtime_error("Option_Log: region smaller than the stored log");
+      }
+    }
+
+    // Returns false if the log is full
+    //
+    template <typename... OPTIONs>
+    bool
+    append(const Optional_Argument<OPTIONs...>& options) noexcept
+    {
+      const std::size_t size = encoded_options_size(options);
+
+      std::uint64_t begin = _header->end.load(std::memory_order_relaxed);
+      do
+      {
+        if (begin + size > _header->capacity) return false;
+      } while (not _header->end.compare_exchange_weak(begin, begin + size,
+                                                      std::memory_order_relaxed));
+
+      // size first: readers can skip the record if we stop before
+      // encode_options() commits it
+      std::byte* const record      = begin_of_records() + begin;
+      const std::uint32_t size_u32 = static_cast<std::uint32_t>(size);
+      std::memcpy(record + offsetof(Option_Record_Header, size), &size_u32, sizeof(size_u32));
+
+      encode_options(options, record);
+      return true;
+    }
+
+    std::size_t
+    size_in_bytes() const
+    {
+      return _header->end.load(std::memory_order_acquire);
+    }
+    std::size_t
+    capacity() const
+    {
+      return _header->capacity;
+    }
+
+    // f(const Option_Record&) for each complete record
+    //
+    template <typename F>
+    Option_Log_Scan
+    for_each_record(F&& f) const
+    {
+      Option_Log_Scan scan;
+
+      const std::byte* p   = begin_of_records();
+      const std::byte* end = p + size_in_bytes();
+
+      while (p < end)
+      {
+        const Option_Record record(p);
+
+        if (record.size() < sizeof(Option_Record_Header) ||
+            record.size() > std::size_t(end - p))
+        {
+          scan.unreadable_bytes = end - p;
+          break;
+        }
+        if (record.is_committed())
+        {
+          f(record);
+          ++scan.records;
+        }
+        else
+        {
+          ++scan.incomplete_records;
+        }
+        p += record.size();
+      }
+      return scan;
+    }
+  };
+
+  //////////////// Deferred text rendering ////////////////
+  //
+  // Decodes the records of one of the PACKs schemas and prints them as
+  // "Tag_Name=value" lines, other records are printed as unknown.
+  // Given but not encoded options are printed as "Tag_Name=<not encoded>",
+  // incomplete records and unreadable bytes are counted at the end.
+  //
+  //   print_option_log<decltype(options)>(std::cout, log);
+  //
+  template <typename... OPTIONs>
+  std::ostream&
+  print_named_options(std::ostream& out, const Optional_Argument<OPTIONs...>& options,
+                      const std::uint64_t unencoded = 0)
+  {
+    std::size_t i = 0;
+
+    [[maybe_unused]] auto print = [&](const auto& option) {
+      using OPTION = std::remove_const_t<std::remove_pointer_t<decltype(present_option(option))>>;
+
+      if constexpr (Is_Binary_Loggable_v<OPTION>)
+      {
+        if (const OPTION* p = present_option(option))
+        {
+          out << Option_Name<OPTION>::value << "=" << *p << " ";
+        }
+      }
+      if (unencoded & (std::uint64_t(1) << i))
+      {
+        out << Option_Name<OPTION>::value << "=<not encoded> ";
+      }
+      ++i;
+    };
+    (print(std::get<OPTIONs>(options)), ...);
+
+    return out;
+  }
+
+  template <typename... PACKs>
+  void
+  print_option_log(std::ostream& out, const Option_Log& log)
+  {
+    const Option_Log_Scan scan = log.for_each_record([&](const Option_Record& record) {
+      const bool known =
+          (((record.has_schema<PACKs>()) &&
+            (print_named_options(out, decode_stored_options<PACKs>(record), record.unencoded()),
+             true)) ||
+           ...);
+      if (not known) out << "unknown schema " << std::hex << record.schema_id() << std::dec;
+      out << "\n";
+    });
+
+    if (scan.incomplete_records != 0)
+    {
+      out << "incomplete records skipped: " << scan.incomplete_records << "\n";
+    }
+    if (scan.unreadable_bytes != 0)
+    {
+      out << "unreadable bytes at the end of the log: " << scan.unreadable_bytes << "\n";
+    }
+  }
+
+#if OPTIONAL_ARGUMENT_HAS_MMAP
+  //////////////// File_Mapping ////////////////
+  //
+  // Shared read/write mapping of a file (POSIX), created if needed and
+  // grown to region_size bytes. Unmapped by the destructor.
+  //
+  class File_Mapping
+  {
+   protected:
+    void* _region;
+    std::size_t _region_size;
+
+   public:
+    // region_size: minimum size, the file size if larger
+    //
+    File_Mapping(const std::string& filename, const std::size_t region_size)
+        : _region(MAP_FAILED), _region_size(region_size)
+    {
+      const int fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+      if (fd < 0) throw std::runtime_error("File_Mapping: cannot open " + filename);
+
+      struct stat file_stat;
+      if (::fstat(fd, &file_stat) == 0 && std::size_t(file_stat.st_size) > _region_size)
+      {
+        _region_size = file_stat.st_size;
+      }
+
+      if (::ftruncate(fd, _region_size) == 0)
+      {
+        _region = ::mmap(nullptr, _region_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      }
+      ::close(fd);
+
+      if (_region == MAP_FAILED)
+      {
+        throw std::runtime_error("File_Mapping: cannot map " + filename);
+      }
+    }
+
+    ~File_Mapping() { ::munmap(_region, _region_size); }
+
+    File_Mapping(const File_Mapping&) = delete;
+    File_Mapping& operator=(const File_Mapping&) = delete;
+
+    void*
+    region() const noexcept
+    {
+      return _region;
+    }
+    std::size_t
+    region_size() const noexcept
+    {
+      return _region_size;
+    }
+  };
+
+  //////////////// Mapped_Option_Log ////////////////
+  //
+  // Option_Log stored in a memory-mapped file (POSIX). An existing log
+  // file is reopened and appended.
+  //
+  // File_Mapping is the first base: constructed before Option_Log,
+  // it unmaps the file if the Option_Log constructor throws.
+  //
+  class Mapped_Option_Log : protected File_Mapping, public Option_Log
+  {
+   public:
+    // region_size: file size in bytes (header included)
+    //
+    Mapped_Option_Log(const std::string& filename, const std::size_t region_size)
+        : File_Mapping(filename, region_size), Option_Log(_region, _region_size)
+    {
+    }
+
+    // Asynchronous write back to the file
+    //
+    void
+    flush() const
+    {
+      ::msync(_region, _region_size, MS_ASYNC);
+    }
+  };
+#endif
+
+}  // namespace OptionalArgument
@@ -0,0 +1,213 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace OptionalArgument
+{
+  //////////////// Option_Group ////////////////
+  //
+  // Options meant for a sub-algorithm, gathered under a name:
+  //
+  //   using Line_Search_Options          = Named_Option_Group<struct Line_Search_Options_Tag>;
+  //   constexpr auto line_search_options = Line_Search_Options();
+  //
+  //   solver(x, tolerance = 1e-8, line_search_options(max_iterations = 10, c1 = 1e-4));
+  //
+  // The solver declares the groups it accepts like any other option,
+  // and hands each sub-algorithm its options:
+  //
+  //   Tolerance tolerance{1e-6};
+  //   Line_Search_Options line_search_options;
+  //
+  //   auto options = take_optional_argument_ref(tolerance, line_search_options);
+  //   optional_argument(options, user_options...);
+  //
+  //   const auto& line_search_user_options =
+  //       project_option_group<Line_Search_Options>(user_options...);
+  //   ...
+  //   line_search(f, x, d, line_search_user_options);
+  //
+  // The projection is a const reference to the options stored in the
+  // group: the group is not dispatched again, but the line search
+  // copies the options into its own slots. An unknown group is
+  // reported by the solver, an unknown option of the group by the line
+  // search. Groups can be nested.
+  //
+  // The group stores the lvalue options by reference, the rvalue ones
+  // are moved in. For a sub-algorithm called once, forward_option_group()
+  // moves the options the group owns into its slots instead:
+  //
+  //   line_search(f, x, d,
+  //               forward_option_group<Line_Search_Options>(
+  //                   std::forward<USER_OPTIONS>(user_options)...));
+  //
+  template <typename TAG, typename... OPTIONs>
+  class Option_Group
+  {
+   public:
+    using tag_type     = TAG;
+    using options_type = Optional_Argument<OPTIONs...>;
+
+   protected:
+    options_type _options;
+
+   public:
+    template <typename... USER_OPTIONs>
+    explicit constexpr Option_Group(USER_OPTIONs&&... user_options)
+        : _options(std::forward<USER_OPTIONs>(user_options)...)
+    {
+    }
+
+    constexpr const options_type&
+    options() const&
+    {
+      return _options;
+    }
+
+    constexpr options_type&&
+    options() &&
+    {
+      return std::move(_options);
+    }
+  };
+
+  // Declares the group: option slot of the algorithm that accepts it,
+  // and syntactic sugar to build it
+  //
+  template <typename TAG>
+  struct Named_Option_Group
+  {
+    using tag_type = TAG;
+
+    template <typename... USER_OPTIONs>
+    constexpr Option_Group<TAG, std::conditional_t<std::is_lvalue_reference_v<USER_OPTIONs>,
+                                                   USER_OPTIONs, std::decay_t<USER_OPTIONs>>...>
+    operator()(USER_OPTIONs&&... user_options) const
+    {
+      return Option_Group<TAG, std::conditional_t<std::is_lvalue_reference_v<USER_OPTIONs>,
+                                                  USER_OPTIONs, std::decay_t<USER_OPTIONs>>...>(
+          std::forward<USER_OPTIONs>(user_options)...);
+    }
+  };
+
+  //////////////// project_option_group() ////////////////
+  //
+  // Count_Option_Group<TAG, T>: number of TAG groups in T, looking
+  // into Optional_Argument packs
+  //
+  template <typename TAG, typename T>
+  struct Count_Option_Group : std::integral_constant<std::size_t, 0>
+  {
+  };
+
+  template <typename TAG, typename... OPTIONs>
+  struct Count_Option_Group<TAG, Option_Group<TAG, OPTIONs...>>
+      : std::integral_constant<std::size_t, 1>
+  {
+  };
+
+  template <typename TAG, typename... OPTIONs>
+  struct Count_Option_Group<TAG, Optional_Argument<OPTIONs...>>
+      : std::integral_constant<std::size_t,
+                               (Count_Option_Group<TAG, std::decay_t<OPTIONs>>::value + ... + 0)>
+  {
+  };
+
+  // Finds the TAG group options: a const reference, or an rvalue one
+  // if the group (or the pack holding it) is a non-const rvalue
+  //
+  template <typename TAG, typename USER_OPTION, typename... USER_OPTIONs>
+  constexpr decltype(auto)
+  find_option_group(USER_OPTION&& user_option, USER_OPTIONs&&... user_options)
+  {
+    using USER_OPTION_TYPE = std::decay_t<USER_OPTION>;
+
+    constexpr bool is_movable =
+        not std::is_lvalue_reference_v<USER_OPTION> && not std::is_const_v<USER_OPTION>;
+
+    if constexpr (Count_Option_Group<TAG, USER_OPTION_TYPE>::value == 0)
+    {
+      return find_option_group<TAG>(std::forward<USER_OPTIONs>(user_options)...);
+    }
+    else if constexpr (Is_Option_Group_v<USER_OPTION_TYPE>)
+    {
+      if constexpr (is_movable)
+      {
+        return std::move(user_option).options();
+      }
+      else
+      {
+        return std::as_const(user_option).options();
+      }
+    }
+    else
+    {
+      using TUPLE = typename USER_OPTION_TYPE::tuple_type;
+      using TUPLE_REFERENCE = std::conditional_t<is_movable, TUPLE&&, const TUPLE&>;
+
+      return std::apply(
+          [](auto&&... options) -> decltype(auto) {
+            return find_option_group<TAG>(std::forward<decltype(options)>(options)...);
+          },
+          static_cast<TUPLE_REFERENCE>(user_option));
+    }
+  }
+
+  // Returns the options of the GROUP group as a const
+  // Optional_Argument<...>& pack, or an empty Optional_Argument<> if
+  // the group was not given
+  //
+  template <typename GROUP, typename... USER_OPTIONs>
+  constexpr decltype(auto)
+  project_option_group(const USER_OPTIONs&... user_options)
+  {
+    using TAG = typename GROUP::tag_type;
+
+    constexpr std::size_t count =
+        (Count_Option_Group<TAG, std::decay_t<USER_OPTIONs>>::value + ... + 0);
+    static_assert(count <= 1, "Option group given several times");
+
+    if constexpr (count == 0)
+    {
+      return Optional_Argument<>();
+    }
+    else
+    {
+      return find_option_group<TAG>(user_options...);
+    }
+  }
+
+  // Same, but the options of an rvalue group are returned as an
+  // Optional_Argument<...>&& pack: the options it owns are moved into
+  // the sub-algorithm slots. To be used once.
+  //
+  template <typename GROUP, typename... USER_OPTIONs>
+  constexpr decltype(auto)
+  forward_option_group(USER_OPTIONs&&... user_options)
+  {
+    using TAG = typename GROUP::tag_type;
+
+    constexpr std::size_t count =
+        (Count_Option_Group<TAG, std::decay_t<USER_OPTIONs>>::value + ... + 0);
+    static_assert(count <= 1, "Option group given several times");
+
+    if constexpr (count == 0)
+    {
+      return Optional_Argument<>();
+    }
+    else
+    {
+      return find_option_group<TAG>(std::forward<USER_OPTIONs>(user_options)...);
+    }
+  }
+
+}  // namespace OptionalArgument
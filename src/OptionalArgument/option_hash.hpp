@@ -0,0 +1,260 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "argument_hash.hpp"
+#include "optional_argument_core.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace OptionalArgument
+{
+  //////////////// Option_Value_Hash ////////////////
+  //
+  // Argument_Hash consistent with operator==: floating point values
+  // are hashed by value, not as raw bytes (+0.0 == -0.0 hash the
+  // same), ranges and tuples containing some are hashed element by
+  // element.
+  //
+  struct Option_Value_Hash
+  {
+    template <typename T>
+    std::size_t
+    operator()(const T& t) const
+    {
+      if constexpr (std::is_floating_point_v<T>)
+      {
+        return Argument_Hash()(t == 0 ? T(0) : t);
+      }
+      else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+      {
+        return Argument_Hash()(t);
+      }
+      else if constexpr (Is_Range_v<T>)
+      {
+        using value_type = std::decay_t<decltype(*std::begin(t))>;
+
+        if constexpr (std::is_integral_v<value_type> || std::is_enum_v<value_type>)
+        {
+          return Argument_Hash()(t);  // raw bytes if contiguous
+        }
+        else
+        {
+          std::size_t h = 0;
+          for (const auto& t_i : t) h = hash_combine(h, (*this)(t_i));
+          return h;
+        }
+      }
+      else if constexpr (Is_Tuple_Like_v<T>)
+      {
+        return std::apply(
+            [this](const auto&... t_i) {
+              std::size_t h = sizeof...(t_i);
+              ((h = hash_combine(h, (*this)(t_i))), ...);
+              return h;
+            },
+            t);
+      }
+      else
+      {
+        return std::hash<T>()(t);
+      }
+    }
+  };
+
+  //////////////// Is_Option_Value_Hashable ////////////////
+  //
+  // True if Option_Value_Hash accepts T: same cases, std::hash<T>
+  // must be enabled for the others.
+  //
+  template <typename T>
+  struct Is_Option_Value_Hashable;
+
+  template <typename T, typename INDEX_SEQUENCE>
+  struct Is_Option_Value_Hashable_Tuple;
+
+  template <typename T, std::size_t... Is>
+  struct Is_Option_Value_Hashable_Tuple<T, std::index_sequence<Is...>>
+      : std::conjunction<Is_Option_Value_Hashable<std::tuple_element_t<Is, T>>...>
+  {
+  };
+
+  template <typename T>
+  struct Is_Option_Value_Hashable
+  {
+    static constexpr bool
+    compute()
+    {
+      if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+      {
+        return true;
+      }
+      else if constexpr (Is_Range_v<T>)
+      {
+        using value_type = std::decay_t<decltype(*std::begin(std::declval<const T&>()))>;
+
+        return Is_Option_Value_Hashable<value_type>::value;
+      }
+      else if constexpr (Is_Tuple_Like_v<T>)
+      {
+        using index_sequence = std::make_index_sequence<std::tuple_size_v<T>>;
+
+        return Is_Option_Value_Hashable_Tuple<T, index_sequence>::value;
+      }
+      else
+      {
+        return std::is_invocable_r_v<std::size_t, std::hash<T>, const T&>;
+      }
+    }
+
+    static constexpr bool value = compute();
+  };
+
+  template <typename T>
+  constexpr auto Is_Option_Value_Hashable_v = Is_Option_Value_Hashable<T>::value;
+
+  //////////////// option_hash() ////////////////
+  //
+  // Hash of an option (by value, see Option_Value_Hash), an empty
+  // std::optional slot and a present one hash differently. T, T& and
+  // std::optional<T> slots holding the same option hash the same.
+  //
+  // Options without operator== have no hash: a pack containing a
+  // Named_Std_Function (std::function payload) cannot be hashed.
+  //
+  template <typename T>
+  std::size_t
+  option_hash(const T& option)
+  {
+    if constexpr (Is_Optional_v<T>)
+    {
+      return option.has_value() ? hash_combine(1, option_hash(*option)) : 0;
+    }
+    else
+    {
+      return Option_Value_Hash()(option);
+    }
+  }
+
+  template <typename... OPTIONs>
+  std::size_t
+  option_hash(const Optional_Argument<OPTIONs...>& options)
+  {
+    return std::apply(
+        [](const auto&... option) {
+          std::size_t h = sizeof...(OPTIONs);
+          ((h = hash_combine(h, option_hash(option))), ...);
+          return h;
+        },
+        static_cast<const typename Optional_Argument<OPTIONs...>::tuple_type&>(options));
+  }
+
+  //////////////// Option_Values_t ////////////////
+  //
+  // Optional_Argument<X&, std::optional<Y>&> -> Optional_Argument<X, std::optional<Y>>
+  //
+  // to store a resolved option pack
+  //
+  template <typename OPTIONS>
+  struct Option_Values;
+
+  template <typename... OPTIONs>
+  struct Option_Values<Optional_Argument<OPTIONs...>>
+  {
+    using type = Optional_Argument<std::remove_reference_t<OPTIONs>...>;
+  };
+
+  template <typename OPTIONS>
+  using Option_Values_t = typename Option_Values<OPTIONS>::type;
+
+  //////////////// Option_Std_Hash ////////////////
+  //
+  // std::hash implementation, disabled (as std::hash of an unhashable
+  // type) if the payload is not Is_Option_Value_Hashable.
+  //
+  template <typename T, typename = void>
+  struct Option_Std_Hash
+  {
+    Option_Std_Hash()                       = delete;
+    Option_Std_Hash(const Option_Std_Hash&) = delete;
+    Option_Std_Hash& operator=(const Option_Std_Hash&) = delete;
+  };
+
+  template <typename TAG, typename T>
+  struct Option_Std_Hash<
+      Named_Type<TAG, T>,
+      std::enable_if_t<std::disjunction_v<std::is_void<T>, Is_Option_Value_Hashable<T>>>>
+  {
+    std::size_t
+    operator()(const Named_Type<TAG, T>& named) const
+    {
+      if constexpr (std::is_void_v<T>)
+      {
+        return 0x9e3779b97f4a7c15ull;
+      }
+      else
+      {
+        return Option_Value_Hash()(named.value());
+      }
+    }
+  };
+
+  template <typename TAG, typename ASSERT, typename T>
+  struct Option_Std_Hash<Named_Assert_Type<TAG, ASSERT, T>,
+                         std::enable_if_t<Is_Option_Value_Hashable_v<T>>>
+  {
+    std::size_t
+    operator()(const Named_Assert_Type<TAG, ASSERT, T>& named) const
+    {
+      return Option_Value_Hash()(named.value());
+    }
+  };
+
+  template <typename... OPTIONs>
+  struct Option_Std_Hash<
+      Optional_Argument<OPTIONs...>,
+      std::enable_if_t<std::conjunction_v<Is_Option_Value_Hashable<Option_Decay_t<OPTIONs>>...>>>
+  {
+    std::size_t
+    operator()(const Optional_Argument<OPTIONs...>& options) const
+    {
+      return option_hash(options);
+    }
+  };
+
+}  // namespace OptionalArgument
+
+//////////////// std::hash ////////////////
+//
+// Named types and option packs can key std::unordered_map & co.
+// Disabled for payloads without hash, by example Named_Std_Function
+// (see option_hash()).
+//
+namespace std
+{
+  template <typename TAG, typename T>
+  struct hash<OptionalArgument::Named_Type<TAG, T>>
+      : OptionalArgument::Option_Std_Hash<OptionalArgument::Named_Type<TAG, T>>
+  {
+  };
+
+  template <typename TAG, typename ASSERT, typename T>
+  struct hash<OptionalArgument::Named_Assert_Type<TAG, ASSERT, T>>
+      : OptionalArgument::Option_Std_Hash<OptionalArgument::Named_Assert_Type<TAG, ASSERT, T>>
+  {
+  };
+
+  template <typename... OPTIONs>
+  struct hash<OptionalArgument::Optional_Argument<OPTIONs...>>
+      : OptionalArgument::Option_Std_Hash<OptionalArgument::Optional_Argument<OPTIONs...>>
+  {
+  };
+}  // namespace std
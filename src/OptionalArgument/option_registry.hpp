@@ -0,0 +1,276 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+#include "thread_index.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Epoch_Domain ////////////////
+  //
+  // Epoch based reclamation (RCU like):
+  //
+  // - a reader announces the global epoch in its slot before reading a
+  //   shared pointer, and clears the slot when done,
+  // - a writer swaps the shared pointer, then retires the old object
+  //   with the current epoch and increments it,
+  // - a retired object is deleted once every active reader announced a
+  //   younger epoch: these readers have seen the new pointer.
+  //
+  // Reader slots are indexed by thread_index(). Reading is
+  // wait-free, except the first read of a thread that must acquire
+  // its index (there are max_thread_indices of them).
+  //
+  class Epoch_Domain
+  {
+   protected:
+    static constexpr std::uint64_t quiescent = 0;
+
+    struct alignas(cache_line_size) Reader_Slot
+    {
+      std::atomic<std::uint64_t> epoch{quiescent};
+      std::size_t nesting = 0;  // only used by the owner thread
+    };
+
+    struct Retired
+    {
+      void* object;
+      void (*deleter)(void*);
+      std::uint64_t epoch;
+    };
+
+    std::atomic<std::uint64_t> _epoch{1};
+    Reader_Slot _slots[max_thread_indices];
+
+    std::mutex _retired_mutex;
+    std::vector<Retired> _retired;
+
+   protected:
+    Epoch_Domain() = default;
+
+    // Returns the number of objects still waiting for reclamation
+    //
+    std::size_t
+    reclaim_locked()
+    {
+      std::uint64_t oldest_active = std::numeric_limits<std::uint64_t>::max();
+      for (const auto& slot : _slots)
+      {
+        const std::uint64_t epoch = slot.epoch.load();
+        if (epoch != quiescent && epoch < oldest_active) oldest_active = epoch;
+      }
+
+      std::size_t kept = 0;
+      for (const auto& retired : _retired)
+      {
+        if (retired.epoch < oldest_active)
+        {
+          retired.deleter(retired.object);
+        }
+        else
+        {
+          _retired[kept++] = retired;
+        }
+      }
+      _retired.resize(kept);
+
+      return kept;
+    }
+
+   public:
+    Epoch_Domain(const Epoch_Domain&) = delete;
+    Epoch_Domain& operator=(const Epoch_Domain&) = delete;
+
+    ~Epoch_Domain()
+    {
+      for (const auto& retired : _retired) retired.deleter(retired.object);
+    }
+
+    static Epoch_Domain&
+    instance()
+    {
+      static Epoch_Domain domain;
+      return domain;
+    }
+
+    // Read-side critical section, can be nested
+    //
+    void
+    enter()
+    {
+      // may throw (too many threads): nothing modified yet
+      Reader_Slot& slot = _slots[thread_index()];
+
+      if (slot.nesting == 0)
+      {
+        // seq_cst: the announce must be visible before the shared
+        // pointer is loaded
+        slot.epoch.store(_epoch.load());
+      }
+      ++slot.nesting;
+    }
+
+    void
+    leave()
+    {
+      Reader_Slot& slot = _slots[thread_index()];
+
+      if (--slot.nesting == 0) slot.epoch.store(quiescent, std::memory_order_release);
+    }
+
+    // Called by writers after the shared pointer has been swapped
+    //
+    template <typename T>
+    void
+    retire(const T* object)
+    {
+      std::lock_guard<std::mutex> lock(_retired_mutex);
+
+      _retired.push_back(
+          Retired{const_cast<T*>(object), [](void* p) { delete static_cast<T*>(p); },
+                  _epoch.fetch_add(1)});
+      reclaim_locked();
+    }
+
+    std::size_t
+    reclaim()
+    {
+      std::lock_guard<std::mutex> lock(_retired_mutex);
+      return reclaim_locked();
+    }
+  };
+
+  //////////////// Option_Snapshot ////////////////
+  //
+  // Read-side guard: the snapshot stays alive as long as the guard
+  // does.
+  //
+  template <typename SNAPSHOT>
+  class Option_Snapshot
+  {
+   protected:
+    const SNAPSHOT* _snapshot;
+
+   public:
+    explicit Option_Snapshot(const std::atomic<const SNAPSHOT*>& current)
+    {
+      Epoch_Domain::instance().enter();
+      _snapshot = current.load();
+    }
+    ~Option_Snapshot() { Epoch_Domain::instance().leave(); }
+
+    Option_Snapshot(const Option_Snapshot&) = delete;
+    Option_Snapshot& operator=(const Option_Snapshot&) = delete;
+
+    const SNAPSHOT& operator*() const noexcept { return *_snapshot; }
+    const SNAPSHOT* operator->() const noexcept { return _snapshot; }
+  };
+
+  //////////////// Option_Registry ////////////////
+  //
+  // Hot-reloadable options for long running services:
+  //
+  //   Option_Registry<Max_Iterations, Absolute_Precision> registry;
+  //
+  //   // service thread, no lock
+  //   my_algorithm(x, *registry.snapshot(), other_options...);
+  //
+  //   // control thread
+  //   registry.update(max_iterations = 50);
+  //
+  // where my_algorithm() calls optional_argument(options,
+  // user_options...) as usual: the snapshot is an
+  // Optional_Argument<std::optional<OPTIONs>...> pack, only its stored
+  // options override the algorithm defaults, the options after it
+  // override it.
+  //
+  // Snapshots are immutable, writers publish a new one (writers are
+  // serialized, readers never wait), old snapshots are reclaimed by
+  // Epoch_Domain.
+  //
+  template <typename... OPTIONs>
+  class Option_Registry
+  {
+    static_assert(Is_Free_Of_Duplicate_Type_v<OPTIONs...>);
+
+   public:
+    using snapshot_type = Optional_Argument<std::optional<OPTIONs>...>;
+
+   protected:
+    std::atomic<const snapshot_type*> _current;
+    std::atomic<std::uint64_t> _version{0};
+    std::mutex _writer_mutex;
+
+    void
+    publish_locked(snapshot_type&& snapshot)
+    {
+      const snapshot_type* old_snapshot = _current.exchange(new snapshot_type(std::move(snapshot)));
+      _version.fetch_add(1, std::memory_order_release);
+
+      Epoch_Domain::instance().retire(old_snapshot);
+    }
+
+   public:
+    template <typename... USER_OPTIONs>
+    explicit Option_Registry(USER_OPTIONs&&... user_options) : _current(new snapshot_type())
+    {
+      snapshot_type& initial = const_cast<snapshot_type&>(*_current.load());
+      optional_argument(initial, std::forward<USER_OPTIONs>(user_options)...);
+    }
+
+    // no reader must remain
+    ~Option_Registry() { delete _current.load(); }
+
+    Option_Registry(const Option_Registry&) = delete;
+    Option_Registry& operator=(const Option_Registry&) = delete;
+
+    Option_Snapshot<snapshot_type>
+    snapshot() const
+    {
+      return Option_Snapshot<snapshot_type>(_current);
+    }
+
+    // Replaces all the options
+    //
+    void
+    publish(snapshot_type snapshot)
+    {
+      std::lock_guard<std::mutex> lock(_writer_mutex);
+      publish_locked(std::move(snapshot));
+    }
+
+    // Overrides some options, keeps the others
+    //
+    template <typename... USER_OPTIONs>
+    void
+    update(USER_OPTIONs&&... user_options)
+    {
+      std::lock_guard<std::mutex> lock(_writer_mutex);
+
+      snapshot_type snapshot = *_current.load();
+      optional_argument(snapshot, std::forward<USER_OPTIONs>(user_options)...);
+      publish_locked(std::move(snapshot));
+    }
+
+    // Number of published snapshots
+    //
+    std::uint64_t
+    version() const
+    {
+      return _version.load(std::memory_order_acquire);
+    }
+  };
+
+}  // namespace OptionalArgument
@@ -0,0 +1,136 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "named_std_function_cache.hpp"
+#include "option_hash.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace OptionalArgument
+{
+  //////////////// input_digest() ////////////////
+  //
+  // Content hash of the algorithm inputs (see Argument_Hash)
+  //
+  template <typename... INPUTs>
+  std::size_t
+  input_digest(const INPUTs&... inputs)
+  {
+    return Argument_Hash()(std::forward_as_tuple(inputs...));
+  }
+
+  //////////////// Option_Result_Cache ////////////////
+  //
+  // Memoizes algorithm results keyed by an input digest and the
+  // resolved options (presence of the std::optional slots included):
+  //
+  //   struct My_Algorithm_Tag;  // namespace scope, not in the function
+  //
+  //   template <typename... USER_OPTIONS>
+  //   Result
+  //   my_algorithm(const std::vector<double>& x, USER_OPTIONS&&... user_options)
+  //   {
+  //     ...
+  //     optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+  //
+  //     auto& cache = option_result_cache<My_Algorithm_Tag, decltype(options), Result>(128);
+  //
+  //     return cache.find_or_compute(input_digest(x), options,
+  //                                  [&]() { return compute(x, options); });
+  //   }
+  //
+  // The inputs are only known by their digest: a digest collision
+  // (probability ~ 2^-64 per pair) returns the result of other inputs.
+  // The options are compared by value.
+  //
+  // Bounded (least recently used results are evicted) and thread-safe.
+  // The computation runs outside any lock: concurrent misses on the
+  // same key may both compute.
+  //
+  template <typename OPTIONS, typename RESULT>
+  class Option_Result_Cache
+  {
+   public:
+    using options_type = Option_Values_t<OPTIONS>;
+    using key_type     = std::tuple<std::size_t, options_type>;
+    using result_type  = RESULT;
+    using cache_type   = LRU_Cache<key_type, result_type>;
+
+   protected:
+    cache_type _cache;
+    std::atomic<std::size_t> _hits{0};
+    std::atomic<std::size_t> _misses{0};
+
+   public:
+    explicit Option_Result_Cache(const std::size_t capacity) : _cache(capacity) {}
+
+    // options can be the algorithm pack (references): it is only
+    // copied when a result is inserted
+    //
+    template <typename OPTIONS_REF, typename COMPUTE>
+    result_type
+    find_or_compute(const std::size_t input_digest, const OPTIONS_REF& options, COMPUTE&& compute)
+    {
+      static_assert(std::is_same_v<Option_Values_t<OPTIONS_REF>, options_type>);
+
+      const auto key = std::forward_as_tuple(input_digest, options);
+
+      if (auto cached = _cache.find(key); cached.has_value())
+      {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return *std::move(cached);
+      }
+
+      _misses.fetch_add(1, std::memory_order_relaxed);
+
+      result_type result = std::forward<COMPUTE>(compute)();
+      _cache.insert(key, result);
+      return result;
+    }
+
+    std::size_t
+    size() const
+    {
+      return _cache.size();
+    }
+
+    std::size_t
+    capacity() const
+    {
+      return _cache.capacity();
+    }
+
+    Cache_Statistics
+    statistics() const
+    {
+      return {_hits.load(std::memory_order_relaxed), _misses.load(std::memory_order_relaxed)};
+    }
+
+    void
+    reset_statistics()
+    {
+      _hits.store(0, std::memory_order_relaxed);
+      _misses.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  // The cache of an algorithm: one per (TAG, OPTIONS, RESULT), hence
+  // shared by all the algorithm instantiations (a static cache in the
+  // algorithm would be per USER_OPTIONS... instantiation). The first
+  // call sets the capacity.
+  //
+  template <typename TAG, typename OPTIONS, typename RESULT>
+  Option_Result_Cache<OPTIONS, RESULT>&
+  option_result_cache(const std::size_t capacity)
+  {
+    static Option_Result_Cache<OPTIONS, RESULT> cache(capacity);
+    return cache;
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,269 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace OptionalArgument
+{
+  //////////////// Option_State ////////////////
+  //
+  // Persistent option values of an algorithm called repeatedly, with
+  // a dirty bit per slot: the algorithm redoes only the setup
+  // affected by the options that changed (warm restart).
+  //
+  //   class Solver
+  //   {
+  //     Option_State<Max_Iterations, std::optional<Lower_Bounds>> _state{Max_Iterations{100},
+  //                                                                      std::nullopt};
+  //
+  //    public:
+  //     template <typename... USER_OPTIONS>
+  //     void
+  //     solve(std::vector<double>& x, USER_OPTIONS&&... user_options)
+  //     {
+  //       optional_argument(_state, std::forward<USER_OPTIONS>(user_options)...);
+  //
+  //       if (_state.is_dirty<Lower_Bounds>()) preprocess_bounds(_state.get<Lower_Bounds>());
+  //       _state.clear_dirty();
+  //       ...
+  //     }
+  //   };
+  //
+  // Like optional_argument(), each call starts from the default
+  // values: an option omitted by a call gets back its default value.
+  // A slot is marked dirty when its value changes (operator==). Slots
+  // whose payload has no operator== (Named_Std_Function, plain
+  // structs...) are marked dirty when given by the user, or when they
+  // get back their default value.
+  // Dirty bits accumulate until cleared by the algorithm, and can
+  // also be set explicitly (mark_dirty()). All slots are initially
+  // dirty.
+  //
+  template <typename... OPTIONs>
+  class Option_State
+  {
+    static_assert((not std::is_reference_v<OPTIONs> && ...), "Option_State stores values");
+
+   public:
+    using options_type    = Optional_Argument<OPTIONs...>;
+    using dirty_mask_type = std::bitset<sizeof...(OPTIONs)>;
+
+   protected:
+    options_type _defaults;
+    options_type _current;
+    options_type _next;  // user options land here before comparison
+
+    dirty_mask_type _dirty;
+    dirty_mask_type _user_set;  // for the slots without operator==
+
+    // records the slots given by the user (see Option_Trace)
+    struct Slot_Tracer
+    {
+      dirty_mask_type& given;
+
+      void
+      operator()(const Option_Trace& trace) const
+      {
+        given.set(trace.slot_index);
+      }
+    };
+
+    template <typename OPTION>
+    static constexpr std::size_t
+    slot_index()
+    {
+      constexpr std::size_t index = Type_Index_v<OPTION, OPTIONs...>;
+
+      if constexpr (index < sizeof...(OPTIONs))
+      {
+        return index;
+      }
+      else
+      {
+        constexpr std::size_t optional_index = Type_Index_v<std::optional<OPTION>, OPTIONs...>;
+        static_assert(optional_index < sizeof...(OPTIONs), "Unexpected type");
+        return optional_index;
+      }
+    }
+
+    template <std::size_t I>
+    void
+    update_slot(const bool is_given)
+    {
+      using SLOT = std::tuple_element_t<I, std::tuple<OPTIONs...>>;
+
+      auto& current        = std::get<I>(_current);
+      auto& next           = std::get<I>(_next);
+      const auto& default_ = std::get<I>(_defaults);
+
+      if constexpr (Is_Equality_Comparable_v<SLOT>)
+      {
+        if (is_given)
+        {
+          if (not(next == current))
+          {
+            std::swap(current, next);
+            _dirty.set(I);
+          }
+        }
+        else if (not(current == default_))
+        {
+          current = default_;
+          _dirty.set(I);
+        }
+      }
+      else
+      {
+        if (is_given)
+        {
+          std::swap(current, next);
+          _dirty.set(I);
+        }
+        else if (_user_set.test(I))
+        {
+          current = default_;
+          _dirty.set(I);
+        }
+        _user_set.set(I, is_given);
+      }
+    }
+
+    template <std::size_t... I>
+    void
+    update_slots(const dirty_mask_type& given, std::index_sequence<I...>)
+    {
+      (update_slot<I>(given.test(I)), ...);
+    }
+
+   public:
+    Option_State() : Option_State(options_type()) {}
+
+    explicit Option_State(OPTIONs... defaults)
+        : Option_State(options_type(std::move(defaults)...))
+    {
+    }
+
+    explicit Option_State(const options_type& defaults)
+        : _defaults(defaults), _current(defaults), _next(defaults), _dirty(), _user_set()
+    {
+      _dirty.set();
+    }
+
+    // Resolves the user options, marks the changed slots dirty and
+    // returns the dirty mask
+    //
+    template <typename... USER_OPTIONs>
+    const dirty_mask_type&
+    update(USER_OPTIONs&&... user_options)
+    {
+      dirty_mask_type given;
+      traced_optional_argument(Slot_Tracer{given}, _next,
+                               std::forward<USER_OPTIONs>(user_options)...);
+
+      update_slots(given, std::index_sequence_for<OPTIONs...>());
+
+      return _dirty;
+    }
+
+    const options_type&
+    options() const noexcept
+    {
+      return _current;
+    }
+
+    // nullptr if OPTION is an empty std::optional<OPTION> slot
+    //
+    template <typename OPTION>
+    const OPTION*
+    find() const
+    {
+      return find_option<OPTION>(_current);
+    }
+
+    template <typename OPTION>
+    const OPTION&
+    get() const
+    {
+      static_assert(Type_Index_v<OPTION, OPTIONs...> < sizeof...(OPTIONs),
+                    "std::optional slot, use find()");
+      return std::get<OPTION>(_current);
+    }
+
+    //// Dirty bits ////
+    //
+    const dirty_mask_type&
+    dirty_mask() const noexcept
+    {
+      return _dirty;
+    }
+
+    // true if one of the OPTION_SUBSET... is dirty, any slot if none
+    // given
+    //
+    template <typename... OPTION_SUBSET>
+    bool
+    is_dirty() const noexcept
+    {
+      if constexpr (sizeof...(OPTION_SUBSET) == 0)
+      {
+        return _dirty.any();
+      }
+      else
+      {
+        return (_dirty.test(slot_index<OPTION_SUBSET>()) || ...);
+      }
+    }
+
+    // all slots if none given
+    //
+    template <typename... OPTION_SUBSET>
+    void
+    mark_dirty() noexcept
+    {
+      if constexpr (sizeof...(OPTION_SUBSET) == 0)
+      {
+        _dirty.set();
+      }
+      else
+      {
+        (_dirty.set(slot_index<OPTION_SUBSET>()), ...);
+      }
+    }
+
+    // all slots if none given
+    //
+    template <typename... OPTION_SUBSET>
+    void
+    clear_dirty() noexcept
+    {
+      if constexpr (sizeof...(OPTION_SUBSET) == 0)
+      {
+        _dirty.reset();
+      }
+      else
+      {
+        (_dirty.reset(slot_index<OPTION_SUBSET>()), ...);
+      }
+    }
+  };
+
+  // optional_argument() updating the state in place
+  //
+  template <typename... OPTIONs, typename... USER_OPTIONs>
+  void
+  optional_argument(Option_State<OPTIONs...>& state, USER_OPTIONs&&... user_options)
+  {
+    state.update(std::forward<USER_OPTIONs>(user_options)...);
+  }
+
+}  // namespace OptionalArgument
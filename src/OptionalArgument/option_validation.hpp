@@ -0,0 +1,446 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <valarray>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Failure policies ////////////////
+  //
+  // What to do when a validation fails
+  //
+  struct Throw_On_Failure
+  {
+    [[noreturn]] void
+    operator()(const char* what) const
+    {
+      throw std::domain_error(what);
+    }
+  };
+
+  // Cheaper than an exception, survives NDEBUG
+  //
+  struct Trap_On_Failure
+  {
+    [[noreturn]] void
+    operator()(const char*) const
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_trap();
+#else
+      std::abort();
+#endif
+    }
+  };
+
+  // No check at all: the predicate is an optimization hint, a failure
+  // is undefined behavior.
+  //
+  struct Assume_On_Failure
+  {
+    [[noreturn]] void
+    operator()(const char*) const
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_unreachable();
+#elif defined(_MSC_VER)
+      __assume(0);
+#else
+      std::abort();
+#endif
+    }
+  };
+
+  //////////////// Contiguous_View ////////////////
+  //
+  // (pointer,size) view of a payload: std::vector, std::array,
+  // std::valarray or a scalar (seen as a 1-element array, is_scalar
+  // set: only scalars are broadcasted)
+  //
+  template <typename T>
+  struct Contiguous_View
+  {
+    const T* data;
+    std::size_t size;
+    bool is_scalar = false;
+  };
+
+  template <typename T>
+  Contiguous_View<T>
+  contiguous_view(const std::vector<T>& v)
+  {
+    return {v.data(), v.size()};
+  }
+
+  template <typename T, std::size_t N>
+  Contiguous_View<T>
+  contiguous_view(const std::array<T, N>& v)
+  {
+    return {v.data(), N};
+  }
+
+  template <typename T>
+  Contiguous_View<T>
+  contiguous_view(const std::valarray<T>& v)
+  {
+    // CAVEAT: &v[0] is UB for empty valarray
+    return {v.size() ? &v[0] : nullptr, v.size()};
+  }
+
+  template <typename T>
+  std::enable_if_t<std::is_arithmetic_v<T>, Contiguous_View<T>>
+  contiguous_view(const T& v)
+  {
+    return {&v, 1, true};
+  }
+
+  // Option -> payload (Named_Type like classes define value())
+  //
+  template <typename T, typename = void>
+  struct Has_Value_Method : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct Has_Value_Method<T, std::void_t<decltype(std::declval<const T&>().value())>>
+      : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr decltype(auto)
+  option_value(const T& option)
+  {
+    if constexpr (Has_Value_Method<T>::value)
+    {
+      return option.value();
+    }
+    else
+    {
+      return option;
+    }
+  }
+
+  //////////////// Vectorized passes ////////////////
+  //
+  // The inner loops have no early exit (results are accumulated with
+  // an int &, a bool & is turned back into a branch by GCC) so that the
+  // compiler can vectorize them. We only branch once per block.
+  //
+  constexpr std::size_t validation_block_size = 256;
+
+  template <typename T, typename PREDICATE>
+  bool
+  all_of_vectorized(const T* const data, const std::size_t n, const PREDICATE predicate)
+  {
+    for (std::size_t block_begin = 0; block_begin < n; block_begin += validation_block_size)
+    {
+      const std::size_t block_end =
+          (n - block_begin < validation_block_size) ? n : block_begin + validation_block_size;
+
+      int ok = 1;
+      for (std::size_t i = block_begin; i < block_end; ++i) ok &= int(predicate(data[i]));
+      if (not ok) return false;
+    }
+    return true;
+  }
+
+  template <typename T, typename PREDICATE>
+  bool
+  all_of_vectorized(const T* const data_0, const T* const data_1, const std::size_t n,
+                    const PREDICATE predicate)
+  {
+    for (std::size_t block_begin = 0; block_begin < n; block_begin += validation_block_size)
+    {
+      const std::size_t block_end =
+          (n - block_begin < validation_block_size) ? n : block_begin + validation_block_size;
+
+      int ok = 1;
+      for (std::size_t i = block_begin; i < block_end; ++i)
+      {
+        ok &= int(predicate(data_0[i], data_1[i]));
+      }
+      if (not ok) return false;
+    }
+    return true;
+  }
+
+  //////////////// Elementwise predicates ////////////////
+  //
+  struct Is_Not_NaN
+  {
+    template <typename T>
+    constexpr bool
+    operator()(const T& t) const
+    {
+      return t == t;
+    }
+  };
+
+  struct Is_Finite
+  {
+    template <typename T>
+    constexpr bool
+    operator()(const T& t) const
+    {
+      // t-t is NaN for +/-inf and NaN
+      return (t - t) == (t - t);
+    }
+  };
+
+  struct Is_Positive
+  {
+    template <typename T>
+    constexpr bool
+    operator()(const T& t) const
+    {
+      return t > 0;
+    }
+  };
+
+  struct Is_Non_Negative
+  {
+    template <typename T>
+    constexpr bool
+    operator()(const T& t) const
+    {
+      return t >= 0;
+    }
+  };
+
+  //////////////// Assert_Predicate ////////////////
+  //
+  // ASSERT functor for Named_Assert_Type, with compile-time checking of
+  // constant values:
+  //
+  //   using Absolute_Precision =
+  //       Named_Assert_Type<struct Absolute_Precision_Tag, Assert_Predicate<Is_Positive>, double>;
+  //
+  //   constexpr Absolute_Precision eps = (absolute_precision = -1e-6);  // does not compile
+  //   my_algorithm(absolute_precision = +1e-6);  // no run-time check left (optimized build)
+  //
+  // - in a constant expression a failure does not compile,
+  // - for run-time values, ON_FAILURE decides: Throw_On_Failure
+  //   (check), Trap_On_Failure (trap) or Assume_On_Failure (assume).
+  //   A value known to the optimizer leaves no run-time check.
+  //
+  // Opt-in, GCC only: with OPTIONAL_ARGUMENT_LITERAL_CHECK=1, a
+  // failing value known at compile time after inlining does not
+  // compile either. Whether a value is known depends on the
+  // optimization level and the inlining decisions: use it as a
+  // diagnostic build, not in the default one. Set it project-wide;
+  // the checked Assert_Predicate lives in its own inline namespace so
+  // that translation units built with and without it do not share
+  // (and violate the ODR of) the same inline function.
+  //
+#ifndef OPTIONAL_ARGUMENT_LITERAL_CHECK
+#define OPTIONAL_ARGUMENT_LITERAL_CHECK 0
+#endif
+
+#if OPTIONAL_ARGUMENT_LITERAL_CHECK && defined(__GNUC__) && !defined(__clang__)
+#define OPTIONAL_ARGUMENT_LITERAL_CHECK_ENABLED 1
+#else
+#define OPTIONAL_ARGUMENT_LITERAL_CHECK_ENABLED 0
+#endif
+
+#if OPTIONAL_ARGUMENT_LITERAL_CHECK_ENABLED
+  [[gnu::error("option value known at compile time fails its Assert_Predicate check")]] void
+  option_literal_check_failed();
+
+  inline namespace Literal_Checked
+  {
+#else
+  inline namespace Literal_Unchecked
+  {
+#endif
+
+  template <typename PREDICATE, typename ON_FAILURE = Throw_On_Failure>
+  struct Assert_Predicate
+  {
+    template <typename T>
+    constexpr void
+    operator()(const T& t) const
+    {
+      const bool ok = PREDICATE()(t);
+
+#if OPTIONAL_ARGUMENT_LITERAL_CHECK_ENABLED
+      if (__builtin_constant_p(ok) && not ok) option_literal_check_failed();
+#endif
+      if (not ok) ON_FAILURE()("Assert_Predicate: predicate failed");
+    }
+  };
+
+  }  // namespace Literal_Checked / Literal_Unchecked
+
+  //////////////// Assert_Elementwise ////////////////
+  //
+  // Container aware ASSERT functor for Named_Assert_Type: checks
+  // PREDICATE on all the payload components with a vectorized pass.
+  //
+  //   template <typename T>
+  //   using Lower_Bounds =
+  //       Named_Assert_Type<struct Lower_Bounds_Tag, Assert_No_NaN<>, std::vector<T>>;
+  //
+  template <typename PREDICATE, typename ON_FAILURE = Throw_On_Failure>
+  struct Assert_Elementwise
+  {
+    template <typename T>
+    void
+    operator()(const T& t) const
+    {
+      const auto view = contiguous_view(t);
+
+      if (not all_of_vectorized(view.data, view.size, PREDICATE()))
+      {
+        ON_FAILURE()("Assert_Elementwise: predicate failed");
+      }
+    }
+  };
+
+  template <typename ON_FAILURE = Throw_On_Failure>
+  using Assert_No_NaN = Assert_Elementwise<Is_Not_NaN, ON_FAILURE>;
+
+  template <typename ON_FAILURE = Throw_On_Failure>
+  using Assert_Finite = Assert_Elementwise<Is_Finite, ON_FAILURE>;
+
+  //////////////// Elementwise relations ////////////////
+  //
+  // Binary predicates on two options, for option_constraint(). A
+  // scalar payload is broadcasted, vectors must have the same size
+  // (a 1-element vector is not a scalar).
+  //
+  template <typename RELATION>
+  struct Elementwise_Relation
+  {
+    template <typename OPTION_0, typename OPTION_1>
+    bool
+    operator()(const OPTION_0& option_0, const OPTION_1& option_1) const
+    {
+      const auto view_0 = contiguous_view(option_value(option_0));
+      const auto view_1 = contiguous_view(option_value(option_1));
+
+      if (view_0.is_scalar || view_1.is_scalar)
+      {
+        const std::size_t n = view_0.is_scalar ? view_1.size : view_0.size;
+
+        if (view_0.is_scalar)
+        {
+          return all_of_vectorized(view_1.data, n, [a = *view_0.data](const auto& b) {
+            return RELATION()(a, b);
+          });
+        }
+        return all_of_vectorized(view_0.data, n, [b = *view_1.data](const auto& a) {
+          return RELATION()(a, b);
+        });
+      }
+
+      return (view_0.size == view_1.size) &&
+             all_of_vectorized(view_0.data, view_1.data, view_0.size, RELATION());
+    }
+  };
+
+  struct Less_Equal
+  {
+    template <typename T>
+    constexpr bool
+    operator()(const T& a, const T& b) const
+    {
+      return a <= b;
+    }
+  };
+
+  struct Less
+  {
+    template <typename T>
+    constexpr bool
+    operator()(const T& a, const T& b) const
+    {
+      return a < b;
+    }
+  };
+
+  using Elementwise_Less_Equal = Elementwise_Relation<Less_Equal>;
+  using Elementwise_Less       = Elementwise_Relation<Less>;
+
+  struct Same_Size
+  {
+    template <typename OPTION_0, typename OPTION_1>
+    bool
+    operator()(const OPTION_0& option_0, const OPTION_1& option_1) const
+    {
+      return contiguous_view(option_value(option_0)).size ==
+             contiguous_view(option_value(option_1)).size;
+    }
+  };
+
+  //////////////// Option_Constraint ////////////////
+  //
+  // A relation between several options of an Optional_Argument pack,
+  // checked once per call after optional_argument():
+  //
+  //   auto options = take_optional_argument_ref(lower_bounds, upper_bounds);
+  //   optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+  //   check_option_constraints(
+  //       options, option_constraint<Lower_Bounds<T>, Upper_Bounds<T>>(
+  //                    Elementwise_Less_Equal(), "lower_bounds <= upper_bounds"));
+  //
+  // A constraint involving an absent std::optional option is skipped.
+  //
+  template <typename PREDICATE, typename... INVOLVED_OPTIONs>
+  struct Option_Constraint
+  {
+    PREDICATE predicate;
+    const char* description;
+
+    template <typename... OPTIONs>
+    bool
+    operator()(const Optional_Argument<OPTIONs...>& options) const
+    {
+      return check(find_option<INVOLVED_OPTIONs>(options)...);
+    }
+
+   private:
+    template <typename... POINTERs>
+    bool
+    check(const POINTERs... pointers) const
+    {
+      if (((pointers == nullptr) || ...)) return true;
+
+      return predicate(*pointers...);
+    }
+  };
+
+  template <typename... INVOLVED_OPTIONs, typename PREDICATE>
+  Option_Constraint<PREDICATE, INVOLVED_OPTIONs...>
+  option_constraint(PREDICATE predicate, const char* description = "Option_Constraint")
+  {
+    static_assert(sizeof...(INVOLVED_OPTIONs) > 0);
+
+    return {std::move(predicate), description};
+  }
+
+  template <typename ON_FAILURE = Throw_On_Failure, typename... OPTIONs, typename... CONSTRAINTs>
+  void
+  check_option_constraints(const Optional_Argument<OPTIONs...>& options,
+                           const CONSTRAINTs&... constraints)
+  {
+    [[maybe_unused]] auto check = [&options](const auto& constraint) {
+      if (not constraint(options)) ON_FAILURE()(constraint.description);
+    };
+
+    (check(constraints), ...);
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,29 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+// C++20 module interface, same content as optional_argument.hpp:
+//
+//   import OptionalArgument;
+//
+// The standard headers are included in the global module fragment,
+// the library headers in the module purview where their namespace is
+// exported.
+//
+module;
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+export module OptionalArgument;
+
+#define OPTIONAL_ARGUMENT_EXPORT export
+
+#include "optional_argument.hpp"
@@ -0,0 +1,618 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+// Minimal core: Optional_Argument, optional_argument(), Named_Type,
+// Named_Assert_Type. Printing is in optional_argument_iostream.hpp,
+// Named_Std_Function in named_std_function.hpp, optional_argument.hpp
+// includes everything.
+//
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Expands to export when the headers are compiled as the
+// OptionalArgument module (see optional_argument.cppm)
+//
+#ifndef OPTIONAL_ARGUMENT_EXPORT
+#define OPTIONAL_ARGUMENT_EXPORT
+#endif
+
+OPTIONAL_ARGUMENT_EXPORT namespace OptionalArgument
+{
+  //////////////// Count_Type_Occurrence ////////////////
+  //
+  template <typename T, typename... Ts>
+  struct Count_Type_Occurence
+      : public std::integral_constant<size_t, (std::is_same_v<T, Ts> + ... + 0)>
+  {
+  };
+  template <typename T, typename... Ts>
+  constexpr auto Count_Type_Occurence_v = Count_Type_Occurence<T, Ts...>::value;
+
+  //////////////// Is_Free_Of_Duplicate_Type ////////////////
+  //
+  template <typename... Ts>
+  struct Is_Free_Of_Duplicate_Type
+      : public std::integral_constant<bool, ((Count_Type_Occurence<Ts, Ts...>::value == 1) && ...)>
+  {
+  };
+
+  template <typename... Ts>
+  constexpr auto Is_Free_Of_Duplicate_Type_v = Is_Free_Of_Duplicate_Type<Ts...>::value;
+
+  //////////////// Is_Optional ////////////////
+  //
+  // Tests if T is of the form std::optional<XXX>
+  //
+  template <typename T>
+  struct Is_Optional : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct Is_Optional<std::optional<T>> : std::true_type
+  {
+  };
+
+  template <typename Ts>
+  constexpr auto Is_Optional_v = Is_Optional<Ts>::value;
+
+  //////////////// type_name() ////////////////
+  //
+  // Compile-time name of T, by example
+  //
+  //   type_name<struct Max_Iterations_Tag>() == "Max_Iterations_Tag"
+  //
+  // Used to report/log options through their tag name.
+  //
+  template <typename T>
+  constexpr std::string_view
+  type_name() noexcept
+  {
+#if defined(__clang__) || defined(__GNUC__)
+    // GCC:   "... type_name() [with T = Max_Iterations_Tag; std::string_view = ...]"
+    // clang: "... type_name() [T = Max_Iterations_Tag]"
+    constexpr std::string_view function_name = __PRETTY_FUNCTION__;
+    constexpr auto begin                     = function_name.find("T = ") + 4;
+    constexpr auto end                       = function_name.find_first_of(";]", begin);
+#elif defined(_MSC_VER)
+    // "... type_name<struct Max_Iterations_Tag>(void) noexcept"
+    constexpr std::string_view function_name = __FUNCSIG__;
+    constexpr auto begin                     = function_name.find("type_name<") + 10;
+    constexpr auto end                       = function_name.rfind(">(void)");
+#else
+#error "type_name(): unsupported compiler"
+#endif
+    return function_name.substr(begin, end - begin);
+  }
+
+  //////////////// Optional_Argument ////////////////
+  //
+  template <typename... OPTIONs>
+  struct Optional_Argument : public std::tuple<OPTIONs...>
+  {
+    using tuple_type = std::tuple<OPTIONs...>;
+    using tuple_type::tuple;
+  };
+
+  template <typename... OPTIONs>
+  Optional_Argument<OPTIONs&...>
+  take_optional_argument_ref(OPTIONs&... options)
+  {
+    return {options...};
+  }
+
+  //////////////// Is_Optional_Argument ////////////////
+  //
+  // Tests if T is of the form Optional_Argument<XXX...>
+  //
+  template <typename T>
+  struct Is_Optional_Argument : std::false_type
+  {
+  };
+
+  template <typename... OPTIONs>
+  struct Is_Optional_Argument<Optional_Argument<OPTIONs...>> : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Optional_Argument_v = Is_Optional_Argument<T>::value;
+
+  //////////////// Is_Option_Group ////////////////
+  //
+  // Tests if T is of the form Option_Group<TAG, XXX...> (see
+  // option_group.hpp)
+  //
+  template <typename TAG>
+  struct Named_Option_Group;
+
+  template <typename TAG, typename... OPTIONs>
+  class Option_Group;
+
+  template <typename T>
+  struct Is_Option_Group : std::false_type
+  {
+  };
+
+  template <typename TAG, typename... OPTIONs>
+  struct Is_Option_Group<Option_Group<TAG, OPTIONs...>> : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Option_Group_v = Is_Option_Group<T>::value;
+
+  //////////////// Option_Decay_t<T> ////////////////
+  //
+  // T                 -> T
+  // T&                -> T
+  // std::optional<T>  -> T
+  // std::optional<T>& -> T
+  //
+  template <typename T>
+  struct Option_Decay
+  {
+    using type = T;
+  };
+  template <typename T>
+  struct Option_Decay<T&>
+  {
+    using type = T;
+  };
+  template <typename T>
+  struct Option_Decay<std::optional<T>>
+  {
+    using type = T;
+  };
+  template <typename T>
+  struct Option_Decay<std::optional<T>&>
+  {
+    using type = T;
+  };
+  template <typename T>
+  using Option_Decay_t = typename Option_Decay<T>::type;
+
+  //////////////// Type_Index ////////////////
+  //
+  // Position of the first occurrence of T in Ts... (sizeof...(Ts) if
+  // not found)
+  //
+  template <typename T, typename... Ts>
+  struct Type_Index
+  {
+   private:
+    static constexpr size_t
+    compute()
+    {
+      constexpr bool is_same[] = {std::is_same_v<T, Ts>..., false};
+
+      size_t i = 0;
+      while (i < sizeof...(Ts) && not is_same[i]) ++i;
+      return i;
+    }
+
+   public:
+    static constexpr size_t value = compute();
+  };
+  template <typename T, typename... Ts>
+  constexpr auto Type_Index_v = Type_Index<T, Ts...>::value;
+
+  //////////////// find_option() ////////////////
+  //
+  // Returns a pointer to the T option of the pack (T, T&,
+  // std::optional<T> or std::optional<T>& slot), nullptr if T is an
+  // empty std::optional<T>.
+  //
+  template <typename T, typename... OPTIONs>
+  const T*
+  find_option(const Optional_Argument<OPTIONs...>& options)
+  {
+    constexpr size_t index = Type_Index_v<T, std::remove_reference_t<OPTIONs>...>;
+
+    if constexpr (index < sizeof...(OPTIONs))
+    {
+      return &std::get<index>(options);
+    }
+    else
+    {
+      constexpr size_t optional_index =
+          Type_Index_v<std::optional<T>, std::remove_reference_t<OPTIONs>...>;
+      static_assert(optional_index < sizeof...(OPTIONs), "Unexpected type");
+
+      const auto& option = std::get<optional_index>(options);
+      return option.has_value() ? &*option : nullptr;
+    }
+  }
+
+  template <typename T, typename... OPTIONs>
+  T*
+  find_option(Optional_Argument<OPTIONs...>& options)
+  {
+    return const_cast<T*>(find_option<T>(std::as_const(options)));
+  }
+
+  //////////////// Option tracing ////////////////
+  //
+  // A tracer is any functor taking an Option_Trace, it is called by
+  // traced_optional_argument() for each resolved user option:
+  //
+  //   traced_optional_argument(tracer, options, user_options...);
+  //
+  // With No_Option_Tracer (what optional_argument() uses) the hook
+  // vanishes at compile time.
+  //
+  enum class Option_Transfer
+  {
+    Copy,
+    Move
+  };
+
+  // The transfer describes the option wrapper only: the value
+  // category of the user option and sizeof(option), its heap allocated
+  // payload not included. A payload copied before, by the syntactic
+  // sugar (starting_point = x copies x), is not seen: the trace
+  // reports the move of the wrapper holding the copy.
+  //
+  struct Option_Trace
+  {
+    std::string_view option_name;      // tag name if any, type name otherwise
+    size_t slot_index;                 // position in Optional_Argument<OPTIONs...>
+    Option_Transfer wrapper_transfer;  // user option lvalue: Copy, rvalue: Move
+    size_t wrapper_size;               // sizeof(option)
+  };
+
+  struct No_Option_Tracer
+  {
+  };
+
+  template <typename T, typename = void>
+  struct Option_Name
+  {
+    static constexpr std::string_view value = type_name<T>();
+  };
+
+  template <typename T>
+  struct Option_Name<T, std::void_t<typename T::tag_type>>
+  {
+    static constexpr std::string_view value = type_name<typename T::tag_type>();
+  };
+
+  //////////////// optional_argument() ////////////////
+  //
+  // A user option can also be an Optional_Argument pack (by example a
+  // snapshot of stored options). Its options are processed in order,
+  // its empty std::optional are ignored:
+  //
+  //   optional_argument(options, stored_options, max_iterations = 10);
+  //
+  // or an Option_Group, forwarded to a sub-algorithm (see
+  // option_group.hpp).
+  //
+  template <typename TRACER, typename... OPTIONs, typename... USER_OPTIONs>
+  void
+  traced_optional_argument(TRACER&& tracer, Optional_Argument<OPTIONs...>& options,
+                           USER_OPTIONs&&... user_options);
+
+  template <typename TRACER, typename... OPTIONs, typename PACK, size_t... I>
+  void
+  unpack_optional_argument(TRACER&& tracer, Optional_Argument<OPTIONs...>& options, PACK&& pack,
+                           std::index_sequence<I...>)
+  {
+    [[maybe_unused]] auto unpack = [&](auto&& user_option) {
+      if constexpr (Is_Optional_v<std::decay_t<decltype(user_option)>>)
+      {
+        if (user_option.has_value())
+        {
+          traced_optional_argument(tracer, options,
+                                   *std::forward<decltype(user_option)>(user_option));
+        }
+      }
+      else
+      {
+        traced_optional_argument(tracer, options, std::forward<decltype(user_option)>(user_option));
+      }
+    };
+
+    (unpack(std::get<I>(std::forward<PACK>(pack))), ...);
+  }
+
+  template <typename TRACER, typename... OPTIONs, typename... USER_OPTIONs>
+  void
+  traced_optional_argument([[maybe_unused]] TRACER&& tracer,
+                           Optional_Argument<OPTIONs...>& options,
+                           USER_OPTIONs&&... user_options)
+  {
+    static_assert(Is_Free_Of_Duplicate_Type_v<Option_Decay_t<USER_OPTIONs>...>);
+    static_assert(Is_Free_Of_Duplicate_Type_v<Option_Decay_t<OPTIONs>...>);
+
+    // USER_OPTION might be  empty
+    [[maybe_unused]] auto dispatch = [&](auto&& user_option) {
+      using USER_OPTION = std::decay_t<decltype(user_option)>;
+
+      if constexpr (Is_Optional_Argument_v<USER_OPTION>)
+      {
+        unpack_optional_argument(
+            tracer, options, std::forward<decltype(user_option)>(user_option),
+            std::make_index_sequence<std::tuple_size_v<typename USER_OPTION::tuple_type>>());
+      }
+      else if constexpr (Is_Option_Group_v<USER_OPTION>)
+      {
+        // only checks that the group is expected, its options are
+        // dispatched by the sub-algorithm (see project_option_group())
+        static_assert(Count_Type_Occurence<Named_Option_Group<typename USER_OPTION::tag_type>,
+                                           std::remove_reference_t<OPTIONs>...>::value == 1,
+                      "Unexpected option group");
+      }
+      else
+      {
+        constexpr size_t occurence_count =
+            Count_Type_Occurence<USER_OPTION, std::remove_reference_t<OPTIONs>...>::value;
+        constexpr size_t occurence_count_by_value =
+            Count_Type_Occurence<USER_OPTION, OPTIONs...>::value;
+        constexpr size_t occurence_count_maybe_optional =
+            Count_Type_Occurence<std::optional<USER_OPTION>,
+                                 std::remove_reference_t<OPTIONs>...>::value;
+        constexpr size_t occurence_count_maybe_optional_by_value =
+            Count_Type_Occurence<std::optional<USER_OPTION>, OPTIONs...>::value;
+
+        static_assert(((occurence_count <= 1) && (occurence_count_maybe_optional <= 1)),
+                      "Internal error, as incompatible with Is_Free_Of_Duplicate_Type");
+        static_assert((occurence_count == 1) || (occurence_count_maybe_optional == 1),
+                      "Unexpected type");
+
+        // If options is a reference use USER_OPTION& too
+        //
+        using SLOT = std::conditional_t<
+            occurence_count == 1,
+            std::conditional_t<occurence_count_by_value, USER_OPTION, USER_OPTION&>,
+            std::conditional_t<occurence_count_maybe_optional_by_value, std::optional<USER_OPTION>,
+                               std::optional<USER_OPTION>&>>;
+
+        if constexpr (not std::is_same_v<std::decay_t<TRACER>, No_Option_Tracer>)
+        {
+          tracer(Option_Trace{Option_Name<USER_OPTION>::value, Type_Index_v<SLOT, OPTIONs...>,
+                              std::is_lvalue_reference_v<decltype(user_option)>
+                                  ? Option_Transfer::Copy
+                                  : Option_Transfer::Move,
+                              sizeof(USER_OPTION)});
+        }
+
+        std::get<SLOT>(options) = std::forward<decltype(user_option)>(user_option);
+      }
+    };
+
+    (dispatch(std::forward<USER_OPTIONs>(user_options)), ...);
+  }
+
+  template <typename... OPTIONs, typename... USER_OPTIONs>
+  void
+  optional_argument(Optional_Argument<OPTIONs...>& options, USER_OPTIONs&&... user_options) noexcept
+  {
+    traced_optional_argument(No_Option_Tracer(), options,
+                             std::forward<USER_OPTIONs>(user_options)...);
+  }
+
+  //////////////// Named_Type ////////////////
+  //
+  // inspired by
+  // https://github.com/joboccara/NamedType/blob/master/named_type_impl.hpp
+  //
+  template <typename OBJ, typename VALUE = typename OBJ::value_type>
+  struct Argument_Syntactic_Sugar
+  {
+    constexpr OBJ
+    operator=(const VALUE& value) const
+    {
+      return OBJ{value};
+    }
+
+    constexpr OBJ
+    operator=(VALUE&& value) const
+    {
+      return OBJ{std::move(value)};
+    }
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  template <typename TAG, typename T = void>
+  class Named_Type
+  {
+    // allowing reference brings some complications we do not really
+    // need here.
+    static_assert(not std::is_reference_v<T>);
+
+   public:
+    using tag_type   = TAG;
+    using value_type = T;
+
+   protected:
+    value_type _value;
+
+   public:
+    constexpr Named_Type() = default;
+
+    // constrained, otherwise std::tuple<Named_Type> takes any tuple
+    // for a Named_Type initializer
+    template <typename _T, typename = std::enable_if_t<std::is_constructible_v<T, _T&&>>>
+    explicit constexpr Named_Type(_T&& value) : _value(std::forward<_T>(value))
+    {
+    }
+
+    constexpr Named_Type&
+    operator=(value_type&& value)
+    {
+      _value = std::move(value);
+      return *this;
+    }
+    constexpr Named_Type&
+    operator=(const value_type& value)
+    {
+      _value = value;
+      return *this;
+    }
+
+    constexpr const value_type&
+    value() const
+    {
+      return _value;
+    }
+
+    constexpr value_type&
+    value()
+    {
+      return _value;
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Type>;
+  };
+
+  // Empty specialization
+  //
+  template <typename TAG>
+  struct Named_Type<TAG>
+  {
+    using tag_type = TAG;
+  };
+
+  //////////////// Is_Equality_Comparable ////////////////
+  //
+  template <typename T, typename = void>
+  struct Is_Equality_Comparable : std::false_type
+  {
+  };
+
+  template <typename T>
+  struct Is_Equality_Comparable<
+      T, std::void_t<decltype(std::declval<const T&>() == std::declval<const T&>())>>
+      : std::true_type
+  {
+  };
+
+  template <typename T>
+  constexpr auto Is_Equality_Comparable_v = Is_Equality_Comparable<T>::value;
+
+  // Equality, by value (flags are always equal). Optional_Argument
+  // packs compare as std::tuple, the presence of their std::optional
+  // slots included.
+  //
+  // Constrained on the payload: Is_Equality_Comparable is false for a
+  // payload without operator==.
+  //
+  template <typename TAG, typename T,
+            typename = std::enable_if_t<std::is_void_v<T> || Is_Equality_Comparable_v<T>>>
+  constexpr bool
+  operator==(const Named_Type<TAG, T>& named_0, const Named_Type<TAG, T>& named_1)
+  {
+    if constexpr (std::is_void_v<T>)
+    {
+      return true;
+    }
+    else
+    {
+      return named_0.value() == named_1.value();
+    }
+  }
+
+  template <typename TAG, typename T,
+            typename = std::enable_if_t<std::is_void_v<T> || Is_Equality_Comparable_v<T>>>
+  constexpr bool
+  operator!=(const Named_Type<TAG, T>& named_0, const Named_Type<TAG, T>& named_1)
+  {
+    return not(named_0 == named_1);
+  }
+
+  ///////////////////////////////////////////////////
+  // Extra, added: Thu 21 Nov 2019 12:34:03 PM CET //
+  ///////////////////////////////////////////////////
+  //
+
+  // Named type with precondition
+  // see: example/
+  //
+  template <typename TAG, typename ASSERT, typename T = void>
+  class Named_Assert_Type
+  {
+    // allowing reference brings some complications we do not really
+    // need here.
+    static_assert(not std::is_reference_v<T>);
+
+   public:
+    using tag_type   = TAG;
+    using value_type = T;
+
+   protected:
+    value_type _value;
+
+   public:
+    constexpr Named_Assert_Type() = default;
+
+    // constrained, otherwise std::tuple<Named_Assert_Type> takes any tuple
+    // for a Named_Assert_Type initializer
+    template <typename _T, typename = std::enable_if_t<std::is_constructible_v<T, _T&&>>>
+    explicit constexpr Named_Assert_Type(_T&& value) : _value(std::forward<_T>(value))
+    {
+      ASSERT()(_value);
+    }
+
+    constexpr Named_Assert_Type&
+    operator=(const value_type& value)
+    {
+      _value = value;
+      ASSERT()(_value);
+      return *this;
+    }
+
+    constexpr Named_Assert_Type&
+    operator=(value_type&& value)
+    {
+      _value = std::move(value);
+      ASSERT()(_value);
+      return *this;
+    }
+
+    constexpr const value_type&
+    value() const
+    {
+      return _value;
+    }
+
+    constexpr value_type&
+    value()
+    {
+      return _value;
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Assert_Type>;
+  };
+
+  template <typename TAG, typename ASSERT, typename T,
+            typename = std::enable_if_t<Is_Equality_Comparable_v<T>>>
+  constexpr bool
+  operator==(const Named_Assert_Type<TAG, ASSERT, T>& named_0,
+             const Named_Assert_Type<TAG, ASSERT, T>& named_1)
+  {
+    return named_0.value() == named_1.value();
+  }
+
+  template <typename TAG, typename ASSERT, typename T,
+            typename = std::enable_if_t<Is_Equality_Comparable_v<T>>>
+  constexpr bool
+  operator!=(const Named_Assert_Type<TAG, ASSERT, T>& named_0,
+             const Named_Assert_Type<TAG, ASSERT, T>& named_1)
+  {
+    return not(named_0 == named_1);
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,74 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+
+#include <ostream>
+
+OPTIONAL_ARGUMENT_EXPORT namespace OptionalArgument
+{
+  //////////////// Printing ////////////////
+  //
+  template <typename... OPTIONs>
+  std::ostream&
+  operator<<(std::ostream& out, const Optional_Argument<OPTIONs...>& options_to_print)
+  {
+    [[maybe_unused]] auto dispatch = [&](const auto& option) {
+      if constexpr (Is_Optional_v<std::decay_t<decltype(option)>>)
+      {
+        if (option.has_value())
+        {
+          out << option.value() << " ";
+        }
+      }
+      else
+      {
+        out << option << " ";
+      }
+    };
+
+    (dispatch(std::get<OPTIONs>(options_to_print)), ...);
+    return out;
+  }
+
+  template <typename TAG, typename T>
+  std::ostream&
+  operator<<(std::ostream& out, const Named_Type<TAG, T>& to_print)
+  {
+    out << to_print.value();
+
+    return out;
+  }
+
+  // Flag (empty specialization)
+  //
+  template <typename TAG>
+  std::ostream&
+  operator<<(std::ostream& out, const Named_Type<TAG>&)
+  {
+    out << "On";
+    return out;
+  }
+
+  template <typename TAG, typename ASSERT, typename T>
+  std::ostream&
+  operator<<(std::ostream& out, const Named_Assert_Type<TAG, ASSERT, T>& to_print)
+  {
+    out << to_print.value();
+
+    return out;
+  }
+
+  inline std::ostream&
+  operator<<(std::ostream& out, const Option_Trace& to_print)
+  {
+    out << to_print.option_name << " slot " << to_print.slot_index << " wrapper "
+        << (to_print.wrapper_transfer == Option_Transfer::Copy ? "copy " : "move ")
+        << to_print.wrapper_size << " bytes";
+    return out;
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,211 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace OptionalArgument
+{
+  //////////////// Dispatch dimensions ////////////////
+  //
+  // A runtime option taking a few values, each one mapped to a
+  // compile-time constant:
+  //
+  //   Flag_Dispatch<Use_Weights>
+  //     flag (present or not) or bool valued Named_Type
+  //     -> std::bool_constant<false|true>
+  //
+  //   Enum_Dispatch<Norm_Option, Norm::L1, Norm::L2, Norm::Linf>
+  //     enum (or integral) valued Named_Type, restricted to the
+  //     declared values (a subset of the enum is allowed)
+  //     -> std::integral_constant<Norm, Norm::L1|Norm::L2|Norm::Linf>
+  //
+  // index(options) returns the position of the runtime value, read
+  // from an Optional_Argument pack. An Enum_Dispatch option must be
+  // present with a declared value, otherwise std::domain_error is
+  // thrown.
+  //
+  template <typename OPTION>
+  struct Flag_Dispatch
+  {
+    using option_type = OPTION;
+
+    static constexpr std::size_t size = 2;
+
+    template <std::size_t I>
+    using constant_type = std::bool_constant<I == 1>;
+
+    template <typename... OPTIONs>
+    static std::size_t
+    index(const Optional_Argument<OPTIONs...>& options)
+    {
+      const OPTION* const option = find_option<OPTION>(options);
+
+      if constexpr (std::is_same_v<OPTION, Named_Type<typename OPTION::tag_type>>)
+      {
+        return option != nullptr;
+      }
+      else
+      {
+        static_assert(std::is_same_v<typename OPTION::value_type, bool>);
+        return option != nullptr && option->value();
+      }
+    }
+  };
+
+  template <typename OPTION, auto... VALUES>
+  struct Enum_Dispatch
+  {
+    using option_type = OPTION;
+    using value_type  = typename OPTION::value_type;
+
+    static_assert(sizeof...(VALUES) > 0);
+    static_assert((std::is_same_v<decltype(VALUES), value_type> && ...));
+
+    static constexpr std::size_t size = sizeof...(VALUES);
+
+    static constexpr value_type values[] = {VALUES...};
+
+    template <std::size_t I>
+    using constant_type = std::integral_constant<value_type, values[I]>;
+
+    template <typename... OPTIONs>
+    static std::size_t
+    index(const Optional_Argument<OPTIONs...>& options)
+    {
+      const OPTION* const option = find_option<OPTION>(options);
+      if (option == nullptr) throw std::domain_error("Enum_Dispatch: missing option");
+
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        if (values[i] == option->value()) return i;
+      }
+      throw std::domain_error("Enum_Dispatch: undeclared option value");
+    }
+  };
+
+  //////////////// static_dispatch() ////////////////
+  //
+  // Runtime option values -> kernel instantiated for constant values:
+  //
+  //   auto options = take_optional_argument_ref(use_weights, norm);
+  //   optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+  //
+  //   return static_dispatch<Flag_Dispatch<Use_Weights>,
+  //                          Enum_Dispatch<Norm_Option, Norm::L1, Norm::L2>>(
+  //       options, [&](auto use_weights, auto norm) {
+  //         // use_weights, norm: compile-time constants
+  //         for (...)
+  //         {
+  //           if constexpr (use_weights) ...
+  //           if constexpr (norm == Norm::L1) ...
+  //         }
+  //       });
+  //
+  // The kernel is instantiated once per combination (the product of
+  // the dimension sizes: keep it small), the instantiations are stored
+  // in a static table of function pointers. A call computes the table
+  // index from the options and makes one indirect call: no branch on
+  // these options is left in the kernel loops. All the
+  // instantiations must return the same type.
+  //
+  template <typename... DIMENSIONs>
+  class Static_Dispatch
+  {
+   public:
+    static constexpr std::size_t size = (DIMENSIONs::size * ... * std::size_t(1));
+
+   protected:
+    static constexpr std::size_t sizes[] = {DIMENSIONs::size..., 0};
+
+    // mixed radix, the last dimension varies fastest
+    static constexpr std::size_t
+    stride(const std::size_t d)
+    {
+      std::size_t stride = 1;
+      for (std::size_t k = d + 1; k < sizeof...(DIMENSIONs); ++k) stride *= sizes[k];
+      return stride;
+    }
+
+    static constexpr std::size_t
+    digit(const std::size_t flat_index, const std::size_t d)
+    {
+      return (flat_index / stride(d)) % sizes[d];
+    }
+
+    template <typename KERNEL, std::size_t FLAT_INDEX, std::size_t... D>
+    static decltype(auto)
+    invoke(KERNEL& kernel, std::index_sequence<D...>)
+    {
+      return kernel(typename std::tuple_element_t<D, std::tuple<DIMENSIONs...>>::
+                        template constant_type<digit(FLAT_INDEX, D)>()...);
+    }
+
+    template <typename KERNEL, std::size_t FLAT_INDEX>
+    static decltype(auto)
+    invoke(KERNEL& kernel)
+    {
+      return invoke<KERNEL, FLAT_INDEX>(kernel, std::index_sequence_for<DIMENSIONs...>());
+    }
+
+    template <typename KERNEL>
+    using result_type = decltype(invoke<KERNEL, 0>(std::declval<KERNEL&>()));
+
+    template <typename KERNEL, std::size_t... FLAT_INDEX>
+    static constexpr auto
+    make_table(std::index_sequence<FLAT_INDEX...>)
+    {
+      static_assert(
+          (std::is_same_v<decltype(invoke<KERNEL, FLAT_INDEX>(std::declval<KERNEL&>())),
+                          result_type<KERNEL>> &&
+           ...),
+          "all the kernel instantiations must return the same type");
+
+      return std::array<result_type<KERNEL> (*)(KERNEL&), size>{&invoke<KERNEL, FLAT_INDEX>...};
+    }
+
+   public:
+    template <typename... OPTIONs>
+    static std::size_t
+    index(const Optional_Argument<OPTIONs...>& options)
+    {
+      return index(options, std::index_sequence_for<DIMENSIONs...>());
+    }
+
+    template <typename KERNEL, typename... OPTIONs>
+    static decltype(auto)
+    dispatch(const Optional_Argument<OPTIONs...>& options, KERNEL&& kernel)
+    {
+      using Kernel = std::remove_reference_t<KERNEL>;
+
+      static constexpr auto table = make_table<Kernel>(std::make_index_sequence<size>());
+
+      return table[index(options)](kernel);
+    }
+
+   protected:
+    template <typename... OPTIONs, std::size_t... D>
+    static std::size_t
+    index(const Optional_Argument<OPTIONs...>& options, std::index_sequence<D...>)
+    {
+      return ((DIMENSIONs::index(options) * stride(D)) + ... + 0);
+    }
+  };
+
+  template <typename... DIMENSIONs, typename KERNEL, typename... OPTIONs>
+  decltype(auto)
+  static_dispatch(const Optional_Argument<OPTIONs...>& options, KERNEL&& kernel)
+  {
+    return Static_Dispatch<DIMENSIONs...>::dispatch(options, std::forward<KERNEL>(kernel));
+  }
+
+}  // namespace OptionalArgument
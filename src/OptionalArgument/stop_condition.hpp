@@ -0,0 +1,326 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "optional_argument_core.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace OptionalArgument
+{
+  //////////////// Coarse_Steady_Clock ////////////////
+  //
+  // std::chrono::steady_clock sampled by a background thread every
+  // resolution: now() is a relaxed atomic load. The thread is started
+  // by the first now() call, which can throw std::system_error (hence
+  // no noexcept, unlike the std::chrono clocks).
+  //
+  // Its time points are std::chrono::steady_clock ones.
+  //
+  class Coarse_Steady_Clock
+  {
+   public:
+    using base_clock = std::chrono::steady_clock;
+    using duration   = base_clock::duration;
+    using rep        = base_clock::rep;
+    using period     = base_clock::period;
+    using time_point = base_clock::time_point;
+
+    static constexpr bool is_steady = true;
+    static constexpr std::chrono::milliseconds resolution{1};
+
+   protected:
+    class Ticker
+    {
+      std::atomic<rep> _now;
+      std::mutex _mutex;
+      std::condition_variable _stop_requested;
+      bool _stop = false;
+      std::thread _thread;
+
+     public:
+      Ticker() : _now(base_clock::now().time_since_epoch().count())
+      {
+        _thread = std::thread([this]() {
+          std::unique_lock<std::mutex> lock(_mutex);
+          while (not _stop_requested.wait_for(lock, resolution, [this]() { return _stop; }))
+          {
+            _now.store(base_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+          }
+        });
+      }
+
+      ~Ticker()
+      {
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _stop = true;
+        }
+        _stop_requested.notify_one();
+        _thread.join();
+      }
+
+      time_point
+      now() const noexcept
+      {
+        return time_point(duration(_now.load(std::memory_order_relaxed)));
+      }
+    };
+
+    static const Ticker&
+    ticker()
+    {
+      static const Ticker ticker;
+      return ticker;
+    }
+
+   public:
+    static time_point
+    now()
+    {
+      return ticker().now();
+    }
+  };
+
+  //////////////// Named_Deadline ////////////////
+  //
+  // Wall-clock deadline option:
+  //
+  //   using Deadline          = Named_Deadline<struct Deadline_Tag>;
+  //   constexpr auto deadline = typename Deadline::argument_syntactic_sugar();
+  //
+  //   solver(x, deadline = std::chrono::milliseconds(50));  // from now
+  //
+  // and in the solver inner loop:
+  //
+  //   if (deadline.should_stop()) break;
+  //
+  // The clock is only read every poll_period() calls (64 by default),
+  // the other calls are a counter decrement. With CLOCK =
+  // Coarse_Steady_Clock, reading the clock is a relaxed atomic load:
+  // use a poll period of 1.
+  //
+  // Without deadline, should_stop() never reads the clock. It is
+  // noexcept if CLOCK::now() is.
+  //
+  template <typename TAG, typename CLOCK = std::chrono::steady_clock>
+  class Named_Deadline
+  {
+   public:
+    using tag_type   = TAG;
+    using clock_type = CLOCK;
+    using value_type = typename CLOCK::time_point;
+
+    static constexpr std::size_t default_poll_period = 64;
+
+   protected:
+    value_type _deadline = value_type::max();
+    std::size_t _poll_period = default_poll_period;
+    std::size_t _countdown   = default_poll_period;
+
+   public:
+    Named_Deadline() = default;
+
+    explicit Named_Deadline(const value_type deadline,
+                            const std::size_t poll_period = default_poll_period) noexcept
+        : _deadline(deadline), _poll_period(poll_period), _countdown(poll_period)
+    {
+      assert(poll_period > 0);
+    }
+
+    template <typename REP, typename PERIOD>
+    explicit Named_Deadline(const std::chrono::duration<REP, PERIOD> time_limit,
+                            const std::size_t poll_period = default_poll_period)
+        : Named_Deadline(CLOCK::now() +
+                             std::chrono::duration_cast<typename CLOCK::duration>(time_limit),
+                         poll_period)
+    {
+    }
+
+    // Same deadline, clock read every poll_period calls
+    //
+    Named_Deadline
+    with_poll_period(const std::size_t poll_period) const noexcept
+    {
+      return Named_Deadline(_deadline, poll_period);
+    }
+
+    bool
+    has_deadline() const noexcept
+    {
+      return _deadline != value_type::max();
+    }
+
+    const value_type&
+    value() const noexcept
+    {
+      return _deadline;
+    }
+
+    std::size_t
+    poll_period() const noexcept
+    {
+      return _poll_period;
+    }
+
+    // Reads the clock
+    //
+    bool
+    is_expired() const noexcept(noexcept(CLOCK::now()))
+    {
+      return has_deadline() && CLOCK::now() >= _deadline;
+    }
+
+    // Amortized is_expired(), for inner loops
+    //
+    bool
+    should_stop() noexcept(noexcept(CLOCK::now()))
+    {
+      if (--_countdown != 0) return false;
+
+      _countdown = _poll_period;
+      return is_expired();
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Deadline>;
+  };
+
+  template <typename TAG, typename CLOCK>
+  struct Argument_Syntactic_Sugar<Named_Deadline<TAG, CLOCK>, typename CLOCK::time_point>
+  {
+    Named_Deadline<TAG, CLOCK>
+    operator=(const typename CLOCK::time_point deadline) const noexcept
+    {
+      return Named_Deadline<TAG, CLOCK>{deadline};
+    }
+    template <typename REP, typename PERIOD>
+    Named_Deadline<TAG, CLOCK>
+    operator=(const std::chrono::duration<REP, PERIOD> time_limit) const
+    {
+      return Named_Deadline<TAG, CLOCK>{time_limit};
+    }
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  //////////////// Cancellation_Flag ////////////////
+  //
+  // Set by any thread, polled by the algorithm. Relaxed accesses: the
+  // flag only requests a stop, it does not publish data.
+  //
+  class Cancellation_Flag
+  {
+   protected:
+    std::atomic<bool> _cancelled{false};
+
+   public:
+    void
+    cancel() noexcept
+    {
+      _cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    void
+    reset() noexcept
+    {
+      _cancelled.store(false, std::memory_order_relaxed);
+    }
+
+    bool
+    is_cancelled() const noexcept
+    {
+      return _cancelled.load(std::memory_order_relaxed);
+    }
+  };
+
+  //////////////// Named_Cancellation ////////////////
+  //
+  // External cancellation option, the caller passes its flag by
+  // reference:
+  //
+  //   using Cancellation          = Named_Cancellation<struct Cancellation_Tag>;
+  //   constexpr auto cancellation = typename Cancellation::argument_syntactic_sugar();
+  //
+  //   Cancellation_Flag flag;  // flag.cancel() from another thread
+  //   solver(x, cancellation = flag);
+  //
+  // and in the solver inner loop:
+  //
+  //   if (cancellation.should_stop()) break;
+  //
+  template <typename TAG>
+  class Named_Cancellation
+  {
+   public:
+    using tag_type   = TAG;
+    using value_type = Cancellation_Flag;
+
+   protected:
+    const Cancellation_Flag* _flag = nullptr;
+
+   public:
+    Named_Cancellation() = default;
+
+    explicit Named_Cancellation(const Cancellation_Flag& flag) noexcept : _flag(&flag) {}
+
+    bool
+    has_flag() const noexcept
+    {
+      return _flag != nullptr;
+    }
+
+    bool
+    should_stop() const noexcept
+    {
+      return _flag && _flag->is_cancelled();
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Cancellation>;
+  };
+
+  // By reference, temporaries are rejected
+  //
+  template <typename TAG>
+  struct Argument_Syntactic_Sugar<Named_Cancellation<TAG>, Cancellation_Flag>
+  {
+    Named_Cancellation<TAG>
+    operator=(const Cancellation_Flag& flag) const noexcept
+    {
+      return Named_Cancellation<TAG>{flag};
+    }
+    void operator=(Cancellation_Flag&&) const = delete;
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  //////////////// should_stop() ////////////////
+  //
+  // Any of the stop conditions:
+  //
+  //   while (not should_stop(deadline, cancellation)) { ... }
+  //
+  template <typename... STOP_CONDITIONs>
+  bool
+  should_stop(STOP_CONDITIONs&... stop_conditions) noexcept(
+      (noexcept(stop_conditions.should_stop()) && ...))
+  {
+    return (stop_conditions.should_stop() || ...);
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,80 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+namespace OptionalArgument
+{
+  // Avoids false sharing between per-thread slots
+  // (std::hardware_destructive_interference_size is not portable yet)
+  //
+  constexpr std::size_t cache_line_size = 64;
+
+  //////////////// thread_index() ////////////////
+  //
+  // Small index of the calling thread, in [0, max_thread_indices):
+  // per-thread data can be stored in an array. The index is acquired
+  // by the first call of a thread, released at its exit and then
+  // reused by another thread.
+  //
+  constexpr std::size_t max_thread_indices = 256;
+
+  class Thread_Index_Pool
+  {
+   protected:
+    std::atomic<bool> _in_use[max_thread_indices] = {};
+
+    Thread_Index_Pool() = default;
+
+   public:
+    Thread_Index_Pool(const Thread_Index_Pool&) = delete;
+    Thread_Index_Pool& operator=(const Thread_Index_Pool&) = delete;
+
+    static Thread_Index_Pool&
+    instance()
+    {
+      static Thread_Index_Pool pool;
+      return pool;
+    }
+
+    std::size_t
+    acquire()
+    {
+      for (std::size_t i = 0; i < max_thread_indices; ++i)
+      {
+        bool expected = false;
+        if (_in_use[i].compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+          return i;
+        }
+      }
+      throw std::length_error("Thread_Index_Pool: too many threads");
+    }
+
+    void
+    release(const std::size_t i) noexcept
+    {
+      _in_use[i].store(false, std::memory_order_release);
+    }
+  };
+
+  inline std::size_t
+  thread_index()
+  {
+    struct Thread_Record
+    {
+      const std::size_t index = Thread_Index_Pool::instance().acquire();
+
+      ~Thread_Record() { Thread_Index_Pool::instance().release(index); }
+    };
+
+    thread_local const Thread_Record record;
+    return record.index;
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,201 @@
+// MIT License
+// Copyright (c) 2019 Picaud Vincent, picaud.vincent at gmail dot com
+// https://github.com/vincent-picaud/OptionalArgument
+//
+#pragma once
+
+#include "named_type_array.hpp"
+#include "optional_argument_core.hpp"
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace OptionalArgument
+{
+  //////////////// Workspace ////////////////
+  //
+  // Scratch memory reused across algorithm calls. The algorithm
+  // declares its needs, the workspace only grows when they exceed its
+  // capacity:
+  //
+  //   auto [gradient, direction] = workspace.acquire(n, n);
+  //
+  // The callers can pre-size it with the same sizes:
+  //
+  //   Workspace<double> workspace(Workspace<double>::required_size(n, n));
+  //
+  template <typename T>
+  class Workspace
+  {
+   public:
+    using value_type = T;
+
+   protected:
+    std::vector<T> _buffer;
+    std::size_t _grow_count = 0;
+
+   public:
+    // No allocation
+    Workspace() = default;
+
+    explicit Workspace(const std::size_t capacity) { reserve(capacity); }
+
+    // a copy would defeat the purpose
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+    Workspace(Workspace&&)                 = default;
+    Workspace& operator=(Workspace&&) = default;
+
+    std::size_t
+    capacity() const noexcept
+    {
+      return _buffer.size();
+    }
+
+    // Number of allocations so far
+    //
+    std::size_t
+    grow_count() const noexcept
+    {
+      return _grow_count;
+    }
+
+    template <typename... SIZEs>
+    static constexpr std::size_t
+    required_size(const SIZEs... sizes) noexcept
+    {
+      return (std::size_t(0) + ... + std::size_t(sizes));
+    }
+
+    // Never shrinks, the content is not preserved. Returns true if it
+    // allocated.
+    //
+    bool
+    reserve(const std::size_t size)
+    {
+      if (size <= _buffer.size()) return false;
+
+      _buffer = std::vector<T>(size);
+      ++_grow_count;
+
+      return true;
+    }
+
+    // Consecutive scratch arrays of the given sizes. Their content is
+    // unspecified, they are invalidated by the next acquire().
+    //
+    template <typename... SIZEs>
+    std::array<Span<T>, sizeof...(SIZEs)>
+    acquire(const SIZEs... sizes)
+    {
+      reserve(required_size(sizes...));
+
+      std::array<Span<T>, sizeof...(SIZEs)> spans;
+      T* data       = _buffer.data();
+      std::size_t i = 0;
+      ((spans[i++] = Span<T>(data, sizes), data += sizes), ...);
+
+      return spans;
+    }
+  };
+
+  //////////////// Named_Workspace ////////////////
+  //
+  // Workspace option, the caller passes its workspace by reference:
+  //
+  //   template <typename T>
+  //   using Solver_Workspace = Named_Workspace<struct Solver_Workspace_Tag, T>;
+  //   template <typename T>
+  //   constexpr auto solver_workspace = typename Solver_Workspace<T>::argument_syntactic_sugar();
+  //
+  //   Workspace<double> workspace;
+  //   for (...) solver(x, solver_workspace<double> = workspace);  // allocates once
+  //
+  // and in the algorithm:
+  //
+  //   Solver_Workspace<T> workspace;  // fallback if omitted
+  //   ...
+  //   auto [gradient, direction] = workspace.value().acquire(n, n);
+  //
+  // When omitted, value() is an internal temporary, allocated by the
+  // first acquire() and freed with the option.
+  //
+  template <typename TAG, typename T>
+  class Named_Workspace
+  {
+   public:
+    using tag_type   = TAG;
+    using value_type = Workspace<T>;
+
+   protected:
+    Workspace<T>* _workspace = nullptr;
+    Workspace<T> _fallback;
+
+   public:
+    Named_Workspace() = default;
+
+    explicit Named_Workspace(Workspace<T>& workspace) noexcept : _workspace(&workspace) {}
+
+    // only the caller workspace reference is copied
+    Named_Workspace(const Named_Workspace& to_copy) noexcept : _workspace(to_copy._workspace) {}
+
+    Named_Workspace&
+    operator=(const Named_Workspace& to_copy) noexcept
+    {
+      _workspace = to_copy._workspace;
+      return *this;
+    }
+
+    bool
+    is_caller_supplied() const noexcept
+    {
+      return _workspace != nullptr;
+    }
+
+    Workspace<T>&
+    value() noexcept
+    {
+      return is_caller_supplied() ? *_workspace : _fallback;
+    }
+
+    const Workspace<T>&
+    value() const noexcept
+    {
+      return is_caller_supplied() ? *_workspace : _fallback;
+    }
+
+    using argument_syntactic_sugar = Argument_Syntactic_Sugar<Named_Workspace>;
+  };
+
+  // By reference, temporaries are rejected
+  //
+  template <typename TAG, typename T>
+  struct Argument_Syntactic_Sugar<Named_Workspace<TAG, T>, Workspace<T>>
+  {
+    Named_Workspace<TAG, T>
+    operator=(Workspace<T>& workspace) const noexcept
+    {
+      return Named_Workspace<TAG, T>{workspace};
+    }
+    void operator=(Workspace<T>&&) const = delete;
+
+    constexpr Argument_Syntactic_Sugar()                      = default;
+    Argument_Syntactic_Sugar(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar(Argument_Syntactic_Sugar&&)      = delete;
+    Argument_Syntactic_Sugar& operator=(const Argument_Syntactic_Sugar&) = delete;
+    Argument_Syntactic_Sugar& operator=(Argument_Syntactic_Sugar&&) = delete;
+  };
+
+  template <typename TAG, typename T>
+  std::ostream&
+  operator<<(std::ostream& out, const Named_Workspace<TAG, T>& to_print)
+  {
+    out << (to_print.is_caller_supplied() ? "workspace(" : "temporary workspace(")
+        << to_print.value().capacity() << ")";
+
+    return out;
+  }
+
+}  // namespace OptionalArgument
@@ -0,0 +1,143 @@
+#include "OptionalArgument/named_async_function.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Objective_Function =
+    Named_Async_Function<struct Objective_Function_Tag, double, const std::vector<double>&>;
+constexpr auto objective_function = Argument_Syntactic_Sugar<Objective_Function>();
+
+using Distance = Named_Async_Function<struct Distance_Tag, double, double, double>;
+constexpr auto distance = Argument_Syntactic_Sugar<Distance>();
+
+double
+sum(const std::vector<double>& x)
+{
+  double s = 0;
+  for (auto x_i : x) s += x_i;
+  return s;
+}
+
+template <typename... USER_OPTIONS>
+double
+my_algorithm(const std::vector<std::vector<double>>& points, USER_OPTIONS&&... user_options)
+{
+  Objective_Function objective_function = (::objective_function = sum);
+
+  auto options = take_optional_argument_ref(objective_function);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  auto in_flight = objective_function.batch(points);
+
+  double best = 1e300;
+  for (auto& y : in_flight) best = std::min(best, y.get());
+  return best;
+}
+
+TEST(Named_Async_Function, batch)
+{
+  const std::vector<std::vector<double>> points{{1, 2}, {-1, 0}, {3, 3}};
+
+  ASSERT_EQ(my_algorithm(points), -1);
+  ASSERT_EQ(my_algorithm(points, objective_function = [](const std::vector<double>& x) {
+                           return -sum(x);
+                         }),
+            -6);
+
+  const auto f = (objective_function = sum);
+  ASSERT_EQ(f(points[2]).get(), 6);
+  ASSERT_EQ(f.wait(points[0]), 3);
+
+  // several arguments: points are tuples
+  const auto d = (distance = [](double a, double b) { return std::abs(a - b); });
+  std::vector<std::tuple<double, double>> pairs{{1, 3}, {4, 1}};
+  auto futures = d.batch(pairs);
+  ASSERT_EQ(wait_all(futures), (std::vector<double>{2, 3}));
+}
+
+TEST(Named_Async_Function, in_flight)
+{
+  const size_t n_threads = 4;
+  auto executor          = std::make_shared<Thread_Pool_Executor>(n_threads);
+
+  // each evaluation waits for the others: only completes if all of
+  // them are in flight at the same time
+  std::mutex mutex;
+  std::condition_variable all_started;
+  size_t started = 0;
+
+  const auto f =
+      (objective_function = [&](const std::vector<double>& x) {
+         std::unique_lock<std::mutex> lock(mutex);
+         if (++started == n_threads) all_started.notify_all();
+         const bool ok = all_started.wait_for(lock, std::chrono::seconds(10),
+                                              [&]() { return started == n_threads; });
+         return ok ? x[0] : -1;
+       }).with_executor(executor);
+
+  auto futures = f.batch(std::vector<std::vector<double>>{{0}, {1}, {2}, {3}});
+  ASSERT_EQ(wait_all(futures), (std::vector<double>{0, 1, 2, 3}));
+}
+
+TEST(Named_Async_Function, exception_and_make_async)
+{
+  const auto f = (objective_function = [](const std::vector<double>& x) -> double {
+    if (x.empty()) throw std::domain_error("empty");
+    return x[0];
+  });
+  auto y = f(std::vector<double>());
+  ASSERT_THROW(y.get(), std::domain_error);
+
+  using Sync_Objective_Function =
+      Named_Std_Function<struct Objective_Function_Tag, double, const std::vector<double>&>;
+  const Sync_Objective_Function g{sum};
+
+  const Objective_Function async_g = make_async(g, std::make_shared<Thread_Pool_Executor>(1));
+  ASSERT_EQ(async_g(std::vector<double>{1, 2}).get(), 3);
+}
+
+TEST(Named_Async_Function, argument_categories)
+{
+  // non-const lvalue reference: the function modifies the task copy
+  using Append = Named_Async_Function<struct Append_Tag, double, std::vector<double>&>;
+  const Append append{[](std::vector<double>& x) {
+    x.push_back(1);
+    return sum(x);
+  }};
+  std::vector<double> x{1, 2};
+  ASSERT_EQ(append(x).get(), 4);
+  ASSERT_EQ(x.size(), 2);
+
+  // move-only
+  using Consume = Named_Async_Function<struct Consume_Tag, int, std::unique_ptr<int>>;
+  const Consume consume{[](std::unique_ptr<int> p) { return *p; }};
+  ASSERT_EQ(consume(std::make_unique<int>(3)).get(), 3);
+
+  // no output
+  using Notify = Named_Async_Function<struct Notify_Tag, void, int>;
+  std::atomic<int> count{0};
+  const Notify notify{[&count](int k) { count += k; }};
+  auto futures = notify.batch(std::vector<int>{1, 2, 3});
+  wait_all(futures);
+  ASSERT_EQ(count, 6);
+
+  // copies from a non-const lvalue: a void function is itself
+  // invocable as a Notify, must not be wrapped again
+  Notify copy_source{[&count](int k) { count += k; }};
+  Notify copy(copy_source);
+  std::optional<Notify> optional_copy;
+  optional_copy = copy_source;
+  copy(1).get();
+  (*optional_copy)(2).get();
+  ASSERT_EQ(count, 9);
+}
@@ -0,0 +1,100 @@
+#include "OptionalArgument/named_broadcast_vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+template <typename T>
+using Lower_Bounds = Named_Broadcast_Vector<struct Lower_Bounds_Tag, T>;
+template <typename T>
+constexpr auto lower_bounds = typename Lower_Bounds<T>::argument_syntactic_sugar();
+
+template <typename T>
+using Upper_Bounds = Named_Broadcast_Vector<struct Upper_Bounds_Tag, T>;
+template <typename T>
+constexpr auto upper_bounds = typename Upper_Bounds<T>::argument_syntactic_sugar();
+
+// projection on [lower_bounds, upper_bounds]
+template <typename T, typename... USER_OPTIONS>
+void
+project(std::vector<T>& x, USER_OPTIONS&&... user_options)
+{
+  Lower_Bounds<T> lower_bound{std::numeric_limits<T>::lowest()};
+  Upper_Bounds<T> upper_bound{std::numeric_limits<T>::max()};
+
+  auto options = take_optional_argument_ref(lower_bound, upper_bound);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  check_option_constraints(options, option_constraint<Lower_Bounds<T>, Upper_Bounds<T>>(
+                                        Elementwise_Less_Equal(), "lower_bounds <= upper_bounds"));
+
+  assert(lower_bound.is_compatible_size(x.size()));
+  assert(upper_bound.is_compatible_size(x.size()));
+
+  const auto lb = lower_bound.view();
+  const auto ub = upper_bound.view();
+  for (std::size_t i = 0; i < x.size(); ++i) x[i] = std::clamp(x[i], lb[i], ub[i]);
+}
+
+TEST(Named_Broadcast_Vector, scalar_or_vector)
+{
+  const auto scalar = (lower_bounds<double> = 0);
+  ASSERT_TRUE(scalar.is_scalar());
+  ASSERT_EQ(scalar.size(), 0);
+  ASSERT_TRUE(scalar.is_compatible_size(1000000));
+  ASSERT_EQ(scalar.view().stride(), 0);
+  ASSERT_EQ(scalar.view()[999999], 0);
+
+  const auto vector = (lower_bounds<double> = {1, 2, 3});
+  ASSERT_FALSE(vector.is_scalar());
+  ASSERT_EQ(vector.size(), 3);
+  ASSERT_FALSE(vector.is_compatible_size(4));
+  ASSERT_EQ(vector.view().stride(), 1);
+  ASSERT_EQ(vector.view()[2], 3);
+
+  ASSERT_EQ(vector, (lower_bounds<double> = std::vector<double>{1, 2, 3}));
+  ASSERT_NE(scalar, (lower_bounds<double> = std::vector<double>{0}));
+
+  std::stringstream out;
+  out << scalar << ", " << vector;
+  ASSERT_EQ(out.str(), "0 (broadcast), 1 2 3 ");
+}
+
+TEST(Named_Broadcast_Vector, algorithm)
+{
+  std::vector<double> x{-2, 0.5, 2};
+
+  project(x, lower_bounds<double> = 0, upper_bounds<double> = 1);
+  ASSERT_EQ(x, (std::vector<double>{0, 0.5, 1}));
+
+  project(x, upper_bounds<double> = {0.25, 0.25, 2});
+  ASSERT_EQ(x, (std::vector<double>{0, 0.25, 1}));
+
+  ASSERT_THROW(project(x, lower_bounds<double> = 1, upper_bounds<double> = {2, 0, 2}),
+               std::domain_error);
+  ASSERT_THROW(project(x, lower_bounds<double> = {0, 3, 0}, upper_bounds<double> = 2),
+               std::domain_error);
+
+  // a 1-element vector is not a scalar
+  ASSERT_THROW(project(x, lower_bounds<double> = {0}, upper_bounds<double> = {1, 1, 1}),
+               std::domain_error);
+}
+
+TEST(Named_Broadcast_Vector, visit)
+{
+  // the kernel is instantiated for each case
+  auto kernel = [](const auto& bound) {
+    using BOUND = std::decay_t<decltype(bound)>;
+    return std::is_same_v<BOUND, Scalar_Broadcast<double>> ? bound[0] : bound[0] + bound[1];
+  };
+
+  ASSERT_EQ((lower_bounds<double> = 2).visit(kernel), 2);
+  ASSERT_EQ((lower_bounds<double> = {2, 3}).visit(kernel), 5);
+}
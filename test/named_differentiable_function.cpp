@@ -0,0 +1,181 @@
+#include "OptionalArgument/named_differentiable_function.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+template <typename T>
+using Objective_Function = Named_Differentiable_Function<struct Objective_Function_Tag, T>;
+template <typename T>
+constexpr auto objective_function = typename Objective_Function<T>::argument_syntactic_sugar();
+
+// fused form only, counts the gradient evaluations
+struct Rosenbrock_with_Gradient
+{
+  std::size_t* gradient_count;
+
+  double
+  operator()(Span<const double> x, Span<double> gradient) const
+  {
+    assert(x.size() == 2);
+
+    const double a = 1 - x[0], b = x[1] - x[0] * x[0];  // shared part
+    if (gradient.size())
+    {
+      ++*gradient_count;
+      gradient[0] = -2 * a - 400 * x[0] * b;
+      gradient[1] = 200 * b;
+    }
+    return a * a + 100 * b * b;
+  }
+};
+
+// fused form and a value only form
+struct Sphere
+{
+  std::size_t value_count = 0;
+
+  double
+  operator()(Span<const double> x)
+  {
+    ++value_count;
+
+    double sum = 0;
+    for (const double x_i : x) sum += x_i * x_i;
+    return sum;
+  }
+
+  double
+  operator()(Span<const double> x, Span<double> gradient)
+  {
+    for (std::size_t i = 0; i < x.size(); ++i) gradient[i] = 2 * x[i];
+    return (*this)(x);
+  }
+};
+
+double
+square(Span<const double> x, Span<double> gradient)
+{
+  if (gradient.size()) gradient[0] = 2 * x[0];
+  return x[0] * x[0];
+}
+
+// a few gradient steps, returns the final value
+template <typename... USER_OPTIONS>
+double
+my_algorithm(std::vector<double>& x, USER_OPTIONS&&... user_options)
+{
+  Objective_Function<double> f;
+
+  auto options = take_optional_argument_ref(f);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  assert(not f.is_empty());
+
+  std::vector<double> gradient(x.size());
+  for (std::size_t iteration = 0; iteration < 10; ++iteration)
+  {
+    f.gradient(x, gradient);
+    for (std::size_t i = 0; i < x.size(); ++i) x[i] -= 1e-3 * gradient[i];
+  }
+  return f(x);
+}
+
+TEST(Named_Differentiable_Function, fused_form)
+{
+  std::size_t gradient_count = 0;
+  const auto f = (objective_function<double> = Rosenbrock_with_Gradient{&gradient_count});
+
+  ASSERT_FALSE(f.is_empty());
+  ASSERT_FALSE(f.has_value_form());
+
+  const std::vector<double> x{-1, 2};
+  std::vector<double> gradient(2);
+
+  // value: gradient skipped
+  ASSERT_EQ(f.value(x), 104);
+  ASSERT_EQ(f(x), 104);
+  ASSERT_EQ(gradient_count, 0);
+
+  ASSERT_EQ(f.value_and_gradient(x, gradient), 104);
+  ASSERT_EQ(gradient, (std::vector<double>{396, 200}));
+  ASSERT_EQ(gradient_count, 1);
+
+  // caller buffer, no allocation
+  double buffer[2] = {};
+  f.gradient(Span<const double>(x.data(), 2), Span<double>(buffer, 2));
+  ASSERT_EQ(buffer[0], 396);
+  ASSERT_EQ(buffer[1], 200);
+  ASSERT_EQ(gradient_count, 2);
+}
+
+TEST(Named_Differentiable_Function, value_form)
+{
+  const auto f = (objective_function<double> = Sphere());
+  ASSERT_TRUE(f.has_value_form());
+
+  std::vector<double> x{1, 2, 3}, gradient(3);
+  ASSERT_EQ(f.value(x), 14);
+  ASSERT_EQ(f.value_and_gradient(x, gradient), 14);
+  ASSERT_EQ(gradient, (std::vector<double>{2, 4, 6}));
+
+  const auto g = (objective_function<double> = square);
+  ASSERT_FALSE(g.has_value_form());
+  ASSERT_EQ(g(std::vector<double>{3}), 9);
+}
+
+// stateful: returns its evaluation count, with or without a value
+// only form
+struct Fused_Counter
+{
+  std::size_t count = 0;
+
+  double
+  operator()(Span<const double>, Span<double>)
+  {
+    return ++count;
+  }
+};
+
+struct Counter : Fused_Counter
+{
+  using Fused_Counter::operator();
+
+  double
+  operator()(Span<const double>)
+  {
+    return ++count;
+  }
+};
+
+TEST(Named_Differentiable_Function, shared_functor)
+{
+  const std::vector<double> x{1};
+
+  // the copies call the same functor object
+  const auto f      = (objective_function<double> = Fused_Counter());
+  const auto f_copy = f;
+  ASSERT_FALSE(f.has_value_form());
+  ASSERT_EQ(f(x), 1);
+  ASSERT_EQ(f_copy(x), 2);
+
+  const auto g      = (objective_function<double> = Counter());
+  const auto g_copy = g;
+  ASSERT_TRUE(g.has_value_form());
+  ASSERT_EQ(g(x), 1);
+  ASSERT_EQ(g_copy(x), 2);
+}
+
+TEST(Named_Differentiable_Function, algorithm)
+{
+  std::vector<double> x{1, -1};
+  const double value = my_algorithm(x, objective_function<double> = Sphere());
+  ASSERT_NEAR(value, 2 * std::pow(1 - 2e-3, 20), 1e-12);
+
+  std::vector<double> y{2};
+  ASSERT_LT(my_algorithm(y, objective_function<double> = square), 4);
+}
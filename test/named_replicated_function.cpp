@@ -0,0 +1,111 @@
+#include "OptionalArgument/named_replicated_function.hpp"
+
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+// a stateful objective: scratch buffer and call counter
+struct Sum_Of_Squares
+{
+  std::vector<double> buffer;
+  std::size_t calls = 0;
+
+  double
+  operator()(const std::vector<double>& x)
+  {
+    ++calls;
+    buffer.resize(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) buffer[i] = x[i] * x[i];
+    return std::accumulate(buffer.begin(), buffer.end(), 0.);
+  }
+};
+
+using Objective_Function =
+    Named_Replicated_Function<struct Objective_Function_Tag, double, const std::vector<double>&>;
+constexpr auto objective_function = typename Objective_Function::argument_syntactic_sugar();
+
+template <typename... USER_OPTIONS>
+Objective_Function
+my_algorithm(USER_OPTIONS&&... user_options)
+{
+  Objective_Function f;
+
+  auto options = take_optional_argument_ref(f);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  return f;
+}
+
+TEST(Named_Replicated_Function, thread_index)
+{
+  const std::size_t main_index = thread_index();
+  ASSERT_LT(main_index, max_thread_indices);
+  ASSERT_EQ(thread_index(), main_index);
+
+  std::size_t other_index = main_index;
+  std::thread([&]() { other_index = thread_index(); }).join();
+  ASSERT_NE(other_index, main_index);
+}
+
+TEST(Named_Replicated_Function, replicas)
+{
+  const Objective_Function f = my_algorithm(objective_function = Sum_Of_Squares());
+
+  ASSERT_FALSE(f.is_empty());
+  ASSERT_EQ(f.replica_count(), 0);
+  ASSERT_EQ(f({1, 2}), 5);
+  ASSERT_EQ(f.replica_count(), 1);
+
+  constexpr std::size_t n_threads = 4, n_calls = 1000;
+
+  std::vector<double> results(n_threads);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < n_threads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      const std::vector<double> x(3, static_cast<double>(t));
+      for (std::size_t i = 0; i < n_calls; ++i) results[t] += f(x);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  for (std::size_t t = 0; t < n_threads; ++t)
+  {
+    ASSERT_EQ(results[t], n_calls * 3. * t * t);
+  }
+
+  // reduction of the per-thread states
+  std::size_t total_calls = 0, replicas = 0;
+  f.reduce<Sum_Of_Squares>([&](const Sum_Of_Squares& replica) {
+    total_calls += replica.calls;
+    ++replicas;
+  });
+  ASSERT_EQ(total_calls, 1 + n_threads * n_calls);
+  ASSERT_EQ(replicas, f.replica_count());
+  ASSERT_GE(replicas, 2);
+  ASSERT_LE(replicas, 1 + n_threads);
+
+  // copies share the replicas
+  const Objective_Function copy = f;
+  ASSERT_EQ(copy.replica_count(), f.replica_count());
+
+  f.clear_replicas();
+  ASSERT_EQ(copy.replica_count(), 0);
+}
+
+TEST(Named_Replicated_Function, function_pointer)
+{
+  const Objective_Function empty = my_algorithm();
+  ASSERT_TRUE(empty.is_empty());
+  ASSERT_EQ(empty.replica_count(), 0);
+
+  const Objective_Function f = my_algorithm(objective_function = [](const std::vector<double>& x) {
+    return static_cast<double>(x.size());
+  });
+  ASSERT_EQ(f({1, 2, 3}), 3);
+}
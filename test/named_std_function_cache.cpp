@@ -0,0 +1,141 @@
+#include "OptionalArgument/named_std_function_cache.hpp"
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <valarray>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Objective_Function =
+    Named_Std_Function<struct Objective_Function_Tag, double, const std::vector<double>&>;
+constexpr auto objective_function = Argument_Syntactic_Sugar<Objective_Function>();
+
+double
+my_algorithm(const Objective_Function& obj_f, const std::vector<double>& x)
+{
+  return obj_f(x);
+}
+
+TEST(Named_Std_Function_Cache, argument_hash)
+{
+  std::vector<double> x{1, 2, 3}, y{1, 2, 3}, z{1, 2, 4};
+
+  ASSERT_EQ(Argument_Hash()(x), Argument_Hash()(y));
+  ASSERT_NE(Argument_Hash()(x), Argument_Hash()(z));
+  ASSERT_EQ(Argument_Hash()(std::make_tuple(x, 1)),
+            Argument_Hash()(std::forward_as_tuple(std::as_const(y), 1)));
+
+  std::valarray<double> v{1, 2, 3};
+  ASSERT_EQ(Argument_Hash()(v), Argument_Hash()(x));
+  ASSERT_TRUE(Argument_Tolerance_Equal()(v, std::valarray<double>{1, 2, 3}));
+
+  ASSERT_TRUE((Argument_Tolerance_Equal{1.5}(x, z)));
+  ASSERT_FALSE((Argument_Tolerance_Equal{0.5}(x, z)));
+}
+
+TEST(Named_Std_Function_Cache, argument_hash_by_value)
+{
+  // equal values, equal hashes
+  ASSERT_EQ(Argument_Hash()(0.0), Argument_Hash()(-0.0));
+  ASSERT_EQ(Argument_Hash()(std::vector<double>{1, 0.0}),
+            Argument_Hash()(std::vector<double>{1, -0.0}));
+  ASSERT_EQ(Argument_Hash()(std::valarray<double>{0.0}),
+            Argument_Hash()(std::valarray<double>{-0.0}));
+
+  // padding bytes are not hashed
+  using Padded = std::pair<char, double>;
+  static_assert(not std::has_unique_object_representations_v<Padded>);
+
+  std::vector<Padded> a{{'a', 1}}, b{{'a', 1}};
+  unsigned char* const b_bytes = reinterpret_cast<unsigned char*>(b.data());
+  for (std::size_t i = sizeof(char); i < offsetof(Padded, second); ++i) b_bytes[i] = 0xff;
+  ASSERT_EQ(Argument_Hash()(a), Argument_Hash()(b));
+}
+
+TEST(Named_Std_Function_Cache, LRU)
+{
+  std::size_t count = 0;
+
+  Named_Std_Function_Cache<Objective_Function, Cache_LRU_Policy> cache(
+      objective_function =
+          [&count](const std::vector<double>& x) {
+            ++count;
+            return x[0];
+          },
+      Cache_LRU_Policy{2});
+
+  std::vector<double> x_1(2, 1), x_2(2, 2), x_3(2, 3);
+
+  ASSERT_EQ(my_algorithm(cache.named_function(), x_1), 1);
+  ASSERT_EQ(my_algorithm(cache.named_function(), x_1), 1);
+  ASSERT_EQ(count, 1);
+  ASSERT_EQ(cache(x_2), 2);
+  ASSERT_EQ(cache(x_1), 1);  // x_1 is now the most recently used
+  ASSERT_EQ(cache(x_3), 3);  // evicts x_2
+  ASSERT_EQ(count, 3);
+  ASSERT_EQ(cache(x_1), 1);
+  ASSERT_EQ(count, 3);
+  ASSERT_EQ(cache(x_2), 2);
+  ASSERT_EQ(count, 4);
+
+  const auto statistics = cache.statistics();
+  ASSERT_EQ(statistics.hits, 3);
+  ASSERT_EQ(statistics.misses, 4);
+}
+
+TEST(Named_Std_Function_Cache, Last_K_tolerance)
+{
+  std::size_t count = 0;
+
+  Named_Std_Function_Cache<Objective_Function, Cache_Last_K_Policy> cache(
+      objective_function =
+          [&count](const std::vector<double>& x) {
+            ++count;
+            return x[0];
+          },
+      Cache_Last_K_Policy{2, 1e-8});
+
+  ASSERT_EQ(cache({1, 1}), 1);
+  ASSERT_EQ(cache({1 + 1e-10, 1}), 1);
+  ASSERT_EQ(count, 1);
+  ASSERT_EQ(cache({2, 1}), 2);
+  ASSERT_EQ(cache({3, 1}), 3);  // evicts {1,1}
+  ASSERT_EQ(cache({1, 1}), 1);
+  ASSERT_EQ(count, 4);
+}
+
+TEST(Named_Std_Function_Cache, concurrent_read_mostly)
+{
+  std::atomic<std::size_t> count{0};
+
+  Named_Std_Function_Cache<Objective_Function, Cache_LRU_Policy> cache(
+      objective_function =
+          [&count](const std::vector<double>& x) {
+            ++count;
+            return x[0] + x[1];
+          },
+      Cache_LRU_Policy{16});
+
+  const Objective_Function f = cache.named_function();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&f]() {
+      for (int i = 0; i < 1000; ++i)
+      {
+        std::vector<double> x{double(i % 8), 1};
+        ASSERT_EQ(f(x), x[0] + 1);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  ASSERT_EQ(cache.statistics().calls(), 4000);
+  ASSERT_EQ(cache.statistics().misses, count);
+  ASSERT_LE(count, 4 * 8);
+}
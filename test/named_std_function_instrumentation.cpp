@@ -0,0 +1,79 @@
+#include "OptionalArgument/named_std_function_instrumentation.hpp"
+
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Objective_Function =
+    Named_Std_Function<struct Objective_Function_Tag, double, const std::vector<double>&>;
+constexpr auto objective_function = Argument_Syntactic_Sugar<Objective_Function>();
+
+using Observer          = Named_Std_Function<struct Observer_Tag, void, const size_t>;
+constexpr auto observer = Argument_Syntactic_Sugar<Observer>();
+
+template <typename... USER_OPTIONS>
+double
+my_algorithm(const std::vector<double>& x, USER_OPTIONS&&... user_options)
+{
+  Objective_Function objective_function{[](const std::vector<double>& x) { return x[0]; }};
+  std::optional<Observer> observer;
+
+  auto options = take_optional_argument_ref(objective_function, observer);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+  instrument_named_functions(options);
+
+  double sum = 0;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    sum += objective_function(x);
+    if (observer.has_value()) (*observer)(i);
+  }
+  return sum;
+}
+
+TEST(Named_Std_Function_Instrumentation, type_name)
+{
+  ASSERT_EQ(type_name<Objective_Function_Tag>(), "Objective_Function_Tag");
+  ASSERT_EQ(type_name<int>(), "int");
+}
+
+TEST(Named_Std_Function_Instrumentation, instrument)
+{
+  call_statistics<Objective_Function_Tag>().reset();
+  call_statistics<Observer_Tag>().reset();
+
+  size_t observer_calls = 0;
+
+  ASSERT_EQ(my_algorithm({1, 2}), 10);
+  ASSERT_EQ(my_algorithm({1, 2}, observer = [&](const size_t) { ++observer_calls; }), 10);
+  ASSERT_EQ(observer_calls, 10);
+
+  ASSERT_EQ(call_statistics<Objective_Function_Tag>().calls, 20);
+  ASSERT_EQ(call_statistics<Observer_Tag>().calls, 10);
+
+  Objective_Function f = instrument(objective_function = [](const std::vector<double>& x) {
+    return x[1];
+  });
+  ASSERT_EQ(f({1, 2}), 2);
+  ASSERT_EQ(call_statistics<Objective_Function_Tag>().calls, 21);
+
+  std::stringstream report;
+  print_instrumentation_report(report);
+  ASSERT_NE(report.str().find("Objective_Function_Tag"), std::string::npos);
+  ASSERT_NE(report.str().find("Observer_Tag"), std::string::npos);
+}
+
+TEST(Named_Std_Function_Instrumentation, histogram)
+{
+  Latency_Histogram histogram;
+
+  for (std::uint64_t ns = 1; ns <= 1000; ++ns) histogram.record(ns);
+
+  // exact up to 25%
+  ASSERT_NEAR(histogram.percentile(0.5), 500, 125);
+  ASSERT_NEAR(histogram.percentile(0.9), 900, 225);
+  ASSERT_GE(histogram.percentile(1), 1000);
+}
@@ -0,0 +1,67 @@
+#include "OptionalArgument/named_type_array.hpp"
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Coordinate = Named_Type<struct Coordinate_Tag, double>;
+
+TEST(Named_Type_Array, layout)
+{
+  ASSERT_TRUE(Has_Value_Layout_v<Coordinate>);
+  ASSERT_TRUE((Has_Value_Layout_v<Named_Type<struct Index_Tag, std::size_t>>));
+  ASSERT_FALSE(Has_Value_Layout_v<double>);  // no value_type
+}
+
+TEST(Named_Type_Array, zero_copy)
+{
+  std::vector<Coordinate> x(10);
+  for (std::size_t i = 0; i < x.size(); ++i) x[i] = double(i);
+
+  Span<double> raw = as_value_span(x);
+  ASSERT_EQ(static_cast<void*>(raw.data()), static_cast<void*>(x.data()));
+  ASSERT_EQ(raw.size(), 10);
+  ASSERT_EQ(raw[3], 3);
+  raw[3] = -3;
+  ASSERT_EQ(x[3].value(), -3);
+
+  std::vector<double> y(5, 2);
+  Span<Coordinate> named = as_named_span<Coordinate>(y);
+  ASSERT_EQ(named[4].value(), 2);
+  named[4] = 4.;
+  ASSERT_EQ(y[4], 4);
+
+  const std::vector<double>& const_y = y;
+  Span<const Coordinate> const_named = as_named_span<Coordinate>(const_y);
+  ASSERT_EQ(const_named[4].value(), 4);
+}
+
+TEST(Named_Type_Array, bulk_operations)
+{
+  const std::size_t n = 1003;
+  std::vector<Coordinate> x(n), y(n), z(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    x[i] = double(i);
+    y[i] = 1.;
+  }
+
+  bulk_axpy(2., make_span(std::as_const(x)), make_span(y));
+  ASSERT_EQ(y[10].value(), 21);
+
+  bulk_transform(make_span(z), make_span(x), make_span(y),
+                 [](const double a, const double b) { return b - 2 * a; });
+  ASSERT_EQ(z[n - 1].value(), 1);
+
+  bulk_apply(make_span(z), [](const double a) { return 3 * a; });
+  ASSERT_EQ(bulk_sum(make_span(z)), 3. * n);
+
+  bulk_transform(make_span(z), make_span(x), [](const double a) { return a; });
+  ASSERT_EQ(bulk_dot(make_span(z), make_span(x)),
+            std::inner_product(as_value_span(x).begin(), as_value_span(x).end(),
+                               as_value_span(x).begin(), 0.));
+}
@@ -0,0 +1,80 @@
+#include "OptionalArgument/normal_sampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+TEST(Normal_Sampler, moments)
+{
+  std::vector<double> sample(100001);
+  normal_sample(sample, sample_seed = 1);
+
+  const double n    = static_cast<double>(sample.size());
+  const double mean = std::accumulate(sample.begin(), sample.end(), 0.) / n;
+  double variance   = 0;
+  for (const double x : sample) variance += (x - mean) * (x - mean);
+  variance /= n - 1;
+
+  ASSERT_NEAR(mean, 0, 0.02);
+  ASSERT_NEAR(variance, 1, 0.02);
+
+  // half-normal: mean sqrt(2/pi)
+  normal_sample(sample, sample_seed = 1, truncated_sample);
+  ASSERT_TRUE(std::all_of(sample.begin(), sample.end(), [](double x) { return x >= 0; }));
+  const double half_normal_mean = std::sqrt(2 / std::acos(-1.));
+  ASSERT_NEAR(std::accumulate(sample.begin(), sample.end(), 0.) / n, half_normal_mean, 0.02);
+}
+
+TEST(Normal_Sampler, reproducible)
+{
+  const std::size_t n = 10001;  // odd
+
+  std::vector<double> reference(n);
+  normal_sample(reference, sample_seed = 7);
+
+  // independent of the thread and block counts
+  for (const std::size_t threads : {2, 3, 8})
+  {
+    for (const std::size_t block_size : {1, 7, 512})
+    {
+      std::vector<double> sample(n);
+      normal_sample(sample, sample_seed = 7, sample_threads = threads,
+                    sample_block_size = block_size);
+      ASSERT_EQ(sample, reference);
+    }
+  }
+
+  // a prefix of the same sequence, the tail is untouched
+  std::vector<double> prefix(n, -100);
+  normal_sample(prefix, sample_seed = 7, sample_size = 11, sample_threads = 4,
+                sample_block_size = 2);
+  ASSERT_TRUE(std::equal(prefix.begin(), prefix.begin() + 11, reference.begin()));
+  ASSERT_EQ(prefix[11], -100);
+
+  // truncation
+  std::vector<double> truncated(n);
+  normal_sample(truncated, truncated_sample, sample_seed = 7);
+  for (std::size_t i = 0; i < n; ++i) ASSERT_EQ(truncated[i], std::abs(reference[i]));
+
+  // other seed, other stream
+  std::vector<double> other(n);
+  normal_sample(other, sample_seed = 8);
+  ASSERT_NE(other, reference);
+  normal_sample(other, sample_seed = 7, sample_stream = 1);
+  ASSERT_NE(other, reference);
+}
+
+TEST(Normal_Sampler, span)
+{
+  float buffer[5];
+  normal_sample(Span<float>(buffer, 5), sample_seed = 7);
+
+  std::vector<double> reference(5);
+  normal_sample(reference, sample_seed = 7);
+  for (std::size_t i = 0; i < 5; ++i) ASSERT_EQ(buffer[i], static_cast<float>(reference[i]));
+}
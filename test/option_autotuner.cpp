@@ -0,0 +1,120 @@
+#include "OptionalArgument/option_autotuner.hpp"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Omega          = Named_Type<struct Omega_Tag, double>;
+constexpr auto omega = typename Omega::argument_syntactic_sugar();
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Block_Size          = Named_Type<struct Block_Size_Tag, int>;
+constexpr auto block_size = typename Block_Size::argument_syntactic_sugar();
+
+using Absolute_Precision          = Named_Type<struct Absolute_Precision_Tag, double>;
+constexpr auto absolute_precision = typename Absolute_Precision::argument_syntactic_sugar();
+
+// a synthetic workload, its cost is minimal for omega = 1.7,
+// max_iterations = 40, block_size = 64
+template <typename... USER_OPTIONS>
+double
+my_algorithm(USER_OPTIONS&&... user_options)
+{
+  Omega omega{1};
+  Max_Iterations max_iterations{100};
+  Block_Size block_size{8};
+  Absolute_Precision absolute_precision{1e-6};
+
+  auto options = take_optional_argument_ref(omega, max_iterations, block_size, absolute_precision);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  const double i = static_cast<double>(max_iterations.value());
+  return std::pow(omega.value() - 1.7, 2) + std::pow((i - 40) / 100, 2) +
+         (block_size.value() == 64 ? 0 : 0.1);
+}
+
+TEST(Option_Autotuner, ranges)
+{
+  ASSERT_EQ(tuning_range<Max_Iterations>(10, 20).decode(0.5).value(), 15);
+  ASSERT_EQ(tuning_range<Max_Iterations>(10, 20).decode(1).value(), 20);
+  ASSERT_NEAR(tuning_log_range<Absolute_Precision>(1e-8, 1e-2).decode(0.5).value(), 1e-5, 1e-15);
+  ASSERT_EQ(tuning_choices<Block_Size>({16, 32, 64}).decode(0).value(), 16);
+  ASSERT_EQ(tuning_choices<Block_Size>({16, 32, 64}).decode(0.5).value(), 32);
+  ASSERT_EQ(tuning_choices<Block_Size>({16, 32, 64}).decode(1).value(), 64);
+}
+
+TEST(Option_Autotuner, autotune)
+{
+  const auto ranges =
+      std::make_tuple(tuning_range<Omega>(1, 2), tuning_range<Max_Iterations>(10, 100),
+                      tuning_choices<Block_Size>({16, 32, 64, 128}));
+
+  size_t cost_calls = 0;
+  const auto result = autotune(
+      [&](const auto& candidate) {
+        ++cost_calls;
+        return my_algorithm(candidate);
+      },
+      ranges, tuning_budget = 300, tuning_seed = 1);
+
+  ASSERT_EQ(result.evaluations, cost_calls);
+  ASSERT_LE(cost_calls, 300);
+  ASSERT_LT(result.best_cost, 1e-3);
+  ASSERT_NEAR(std::get<Omega>(result.best).value(), 1.7, 0.03);
+  ASSERT_NEAR(std::get<Max_Iterations>(result.best).value(), 40, 3);
+  ASSERT_EQ(std::get<Block_Size>(result.best).value(), 64);
+
+  // the result is a user option
+  ASSERT_EQ(my_algorithm(result.best), result.best_cost);
+
+  // reproducible
+  const auto again =
+      autotune([](const auto& candidate) { return my_algorithm(candidate); }, ranges,
+               tuning_budget = 300, tuning_seed = 1);
+  ASSERT_TRUE(again.best == result.best);
+
+  // runtime cost
+  const auto timed =
+      autotune(benchmark_cost([](const auto& candidate) { my_algorithm(candidate); }),
+               std::make_tuple(tuning_range<Omega>(1, 2)), tuning_budget = 4);
+  ASSERT_GE(timed.best_cost, 0);
+  ASSERT_LE(timed.evaluations, 4);
+
+  // no evaluation allowed
+  ASSERT_THROW(autotune([](const auto& candidate) { return my_algorithm(candidate); }, ranges,
+                        tuning_budget = 0),
+               std::invalid_argument);
+}
+
+TEST(Option_Autotuner, preset)
+{
+  const Optional_Argument<Omega, Max_Iterations> best{omega = 1.0 / 3, max_iterations = 42};
+
+  std::stringstream file;
+  save_option_preset(file, best);
+  ASSERT_EQ(file.str(), "Omega_Tag 0.33333333333333331\nMax_Iterations_Tag 42\n");
+
+  using Preset = Optional_Argument<Omega, Max_Iterations, Block_Size>;
+  const auto preset = load_option_preset<Preset>(file);
+  static_assert(
+      std::is_same_v<decltype(preset),
+                     const Optional_Argument<std::optional<Omega>, std::optional<Max_Iterations>,
+                                             std::optional<Block_Size>>>);
+  ASSERT_EQ(std::get<0>(preset)->value(), 1.0 / 3);
+  ASSERT_EQ(std::get<1>(preset)->value(), 42);
+  ASSERT_FALSE(std::get<2>(preset).has_value());
+
+  // missing options keep their default
+  ASSERT_EQ(my_algorithm(preset), my_algorithm(omega = 1.0 / 3, max_iterations = 42));
+
+  std::stringstream unknown("Foo_Tag 1\n");
+  ASSERT_THROW(load_option_preset<Preset>(unknown), std::runtime_error);
+  std::stringstream bad_value("Block_Size_Tag abc\n");
+  ASSERT_THROW(load_option_preset<Preset>(bad_value), std::runtime_error);
+}
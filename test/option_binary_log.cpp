@@ -0,0 +1,268 @@
+#include "OptionalArgument/option_binary_log.hpp"
+#include "OptionalArgument/named_type_array.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Absolute_Precision          = Named_Type<struct Absolute_Precision_Tag, double>;
+constexpr auto absolute_precision = typename Absolute_Precision::argument_syntactic_sugar();
+
+using Starting_Point          = Named_Type<struct Starting_Point_Tag, std::vector<double>>;
+constexpr auto starting_point = typename Starting_Point::argument_syntactic_sugar();
+
+using Use_Line_Search = Named_Type<struct Use_Line_Search_Tag>;
+constexpr auto use_line_search = Use_Line_Search();
+
+// pointer-bearing payloads: not loggable
+using Name      = Named_Type<struct Name_Tag, std::string_view>;
+using Weights   = Named_Type<struct Weights_Tag, Span<const double>>;
+using Reference = Named_Type<struct Reference_Tag, const double*>;
+
+// self-contained payload, opt-in
+using Box = Named_Type<struct Box_Tag, std::array<double, 2>>;
+
+namespace OptionalArgument
+{
+  template <>
+  struct Is_Binary_Loggable<Box> : std::true_type
+  {
+  };
+}  // namespace OptionalArgument
+
+using Options = Optional_Argument<Max_Iterations&, Absolute_Precision&,
+                                  std::optional<Starting_Point>&, std::optional<Use_Line_Search>&>;
+
+template <typename... USER_OPTIONS>
+void
+my_algorithm(Option_Log& log, USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{10};
+  Absolute_Precision absolute_precision{1e-6};
+  std::optional<Starting_Point> starting_point;
+  std::optional<Use_Line_Search> use_line_search;
+
+  auto options = take_optional_argument_ref(max_iterations, absolute_precision, starting_point,
+                                            use_line_search);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  static_assert(std::is_same_v<decltype(options), Options>);
+  ASSERT_TRUE(log.append(options));
+}
+
+TEST(Option_Binary_Log, encode_decode)
+{
+  static_assert(Is_Binary_Loggable_v<Max_Iterations>);
+  static_assert(not Is_Binary_Loggable_v<Starting_Point>);
+  static_assert(Option_Pack_Schema<Options>::id ==
+                Option_Pack_Schema<Optional_Argument<Max_Iterations, Absolute_Precision,
+                                                     Starting_Point, Use_Line_Search>>::id);
+  static_assert(Option_Pack_Schema<Optional_Argument<Max_Iterations, Absolute_Precision>>::id !=
+                Option_Pack_Schema<Optional_Argument<Absolute_Precision, Max_Iterations>>::id);
+
+  Optional_Argument<Max_Iterations, std::optional<Absolute_Precision>, Starting_Point> options{
+      max_iterations = 5, std::nullopt, starting_point = std::vector<double>(3)};
+
+  alignas(8) std::byte buffer[max_option_record_size<decltype(options)>];
+  const size_t size = encode_options(options, buffer);
+  ASSERT_EQ(size, encoded_options_size(options));
+  ASSERT_EQ(size % 8, 0);
+
+  const Option_Record record(buffer);
+  ASSERT_EQ(record.size(), size);
+  ASSERT_EQ(record.presence(), 1);   // Starting_Point is not loggable
+  ASSERT_EQ(record.unencoded(), 4);  // but given
+
+  ASSERT_THROW(decode_options<decltype(options)>(record), std::runtime_error);
+
+  const auto decoded = decode_stored_options<decltype(options)>(record);
+  ASSERT_EQ(std::get<0>(decoded)->value(), 5);
+  ASSERT_FALSE(std::get<1>(decoded).has_value());
+  ASSERT_FALSE(std::get<2>(decoded).has_value());
+
+  ASSERT_THROW(decode_options<Optional_Argument<Max_Iterations>>(record), std::runtime_error);
+}
+
+TEST(Option_Binary_Log, log)
+{
+  std::vector<std::uint64_t> region(64);
+  Option_Log log(region.data(), region.size() * sizeof(std::uint64_t));
+
+  my_algorithm(log);
+  my_algorithm(log, max_iterations = 20, use_line_search);
+  my_algorithm(log, absolute_precision = 0.5, starting_point = std::vector<double>(2));
+
+  Optional_Argument<Max_Iterations> other{max_iterations = 1};
+  ASSERT_TRUE(log.append(other));
+
+  // replay the second run
+  std::vector<Option_Record> records;
+  log.for_each_record([&](const Option_Record& record) { records.push_back(record); });
+  ASSERT_EQ(records.size(), 4);
+
+  Optional_Argument<Max_Iterations, Absolute_Precision, std::optional<Starting_Point>,
+                    std::optional<Use_Line_Search>>
+      replayed;
+  optional_argument(replayed, decode_options<Options>(records[1]));
+  ASSERT_EQ(std::get<0>(replayed).value(), 20);
+  ASSERT_EQ(std::get<1>(replayed).value(), 1e-6);
+  ASSERT_TRUE(std::get<3>(replayed).has_value());
+
+  // the third run was given a starting point: cannot be replayed
+  ASSERT_EQ(records[2].unencoded(), 4);
+  ASSERT_THROW(decode_options<Options>(records[2]), std::runtime_error);
+
+  std::stringstream text;
+  print_option_log<Options>(text, log);
+
+  std::string line;
+  std::getline(text, line);
+  ASSERT_EQ(line, "Max_Iterations_Tag=10 Absolute_Precision_Tag=1e-06 ");
+  std::getline(text, line);
+  ASSERT_EQ(line, "Max_Iterations_Tag=20 Absolute_Precision_Tag=1e-06 Use_Line_Search_Tag=On ");
+  std::getline(text, line);
+  ASSERT_EQ(line,
+            "Max_Iterations_Tag=10 Absolute_Precision_Tag=0.5 Starting_Point_Tag=<not encoded> ");
+  std::getline(text, line);
+  ASSERT_EQ(line.find("unknown schema"), 0);
+
+  // full
+  while (log.append(other))
+    ;
+  ASSERT_LE(log.size_in_bytes(), log.capacity());
+}
+
+TEST(Option_Binary_Log, interrupted_writer)
+{
+  std::vector<std::uint64_t> region(64);
+  Option_Log log(region.data(), region.size() * sizeof(std::uint64_t));
+
+  Optional_Argument<Max_Iterations> options{max_iterations = 1};
+  ASSERT_TRUE(log.append(options));
+  ASSERT_TRUE(log.append(options));
+  ASSERT_TRUE(log.append(options));
+  const size_t record_size = encoded_options_size(options);
+
+  // a writer stopped after writing the size of the second record:
+  // skipped, the third one is still read
+  std::vector<const std::byte*> records;
+  log.for_each_record([&](const Option_Record& record) { records.push_back(record.data()); });
+  std::byte* const second = const_cast<std::byte*>(records[1]);
+  std::memset(second + offsetof(Option_Record_Header, committed), 0, sizeof(std::uint32_t));
+
+  size_t count = 0;
+  Option_Log_Scan scan = log.for_each_record([&](const Option_Record&) { ++count; });
+  ASSERT_EQ(count, 2);
+  ASSERT_EQ(scan.records, 2);
+  ASSERT_EQ(scan.incomplete_records, 1);
+  ASSERT_EQ(scan.unreadable_bytes, 0);
+
+  // stopped before writing the size: the rest is reported as lost
+  std::memset(second, 0, record_size);
+
+  count = 0;
+  scan  = log.for_each_record([&](const Option_Record&) { ++count; });
+  ASSERT_EQ(count, 1);
+  ASSERT_EQ(scan.unreadable_bytes, 2 * record_size);
+
+  std::stringstream text;
+  print_option_log<decltype(options)>(text, log);
+  ASSERT_EQ(text.str(),
+            "Max_Iterations_Tag=1 \nunreadable bytes at the end of the log: " +
+                std::to_string(2 * record_size) + "\n");
+}
+
+#if OPTIONAL_ARGUMENT_HAS_MMAP
+TEST(Option_Binary_Log, mapped_file)
+{
+  const std::string filename = testing::TempDir() + "option_binary_log_test.bin";
+  std::remove(filename.c_str());
+
+  Optional_Argument<Max_Iterations, Absolute_Precision> options{max_iterations = 3,
+                                                                absolute_precision = 0.25};
+  {
+    Mapped_Option_Log log(filename, 4096);
+    ASSERT_TRUE(log.append(options));
+  }
+  {
+    // reopened and appended
+    Mapped_Option_Log log(filename, 4096);
+    ASSERT_TRUE(log.append(options));
+
+    size_t count = 0;
+    log.for_each_record([&](const Option_Record& record) {
+      const auto decoded = decode_options<decltype(options)>(record);
+      ASSERT_EQ(std::get<0>(decoded)->value(), 3);
+      ASSERT_EQ(std::get<1>(decoded)->value(), 0.25);
+      ++count;
+    });
+    ASSERT_EQ(count, 2);
+  }
+  std::remove(filename.c_str());
+}
+
+TEST(Option_Binary_Log, mapped_file_error)
+{
+  const std::string filename = testing::TempDir() + "option_binary_log_error_test.bin";
+  std::remove(filename.c_str());
+
+  // stored capacity larger than the file: Option_Log throws
+  {
+    const std::uint64_t header[4] = {Option_Log::magic, 1 << 20, 0, 0};
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(header, sizeof(header), 1, file);
+    std::fclose(file);
+  }
+  ASSERT_THROW(Mapped_Option_Log(filename, 4096), std::runtime_error);
+
+#ifdef __linux__
+  // and the file is unmapped
+  std::ifstream maps("/proc/self/maps");
+  const std::string mapped((std::istreambuf_iterator<char>(maps)),
+                           std::istreambuf_iterator<char>());
+  ASSERT_EQ(mapped.find("option_binary_log_error_test.bin"), std::string::npos);
+#endif
+  std::remove(filename.c_str());
+}
+#endif
+
+TEST(Option_Binary_Log, loggable_payloads)
+{
+  static_assert(Is_Binary_Loggable_v<Use_Line_Search>);
+  static_assert(not Is_Binary_Loggable_v<Name>);
+  static_assert(not Is_Binary_Loggable_v<Weights>);
+  static_assert(not Is_Binary_Loggable_v<Reference>);
+  static_assert(Is_Binary_Loggable_v<Box>);
+
+  const double x[2] = {1, 2};
+  Optional_Argument<Box, Name, Weights, Reference> options{
+      Box(std::array<double, 2>{3, 4}), Name("name"), Weights(Span<const double>(x, 2)),
+      Reference(x)};
+
+  alignas(8) std::byte buffer[max_option_record_size<decltype(options)>];
+  encode_options(options, buffer);
+
+  const Option_Record record(buffer);
+  ASSERT_EQ(record.presence(), 1);
+  ASSERT_EQ(record.unencoded(), 2 + 4 + 8);
+  ASSERT_THROW(decode_options<decltype(options)>(record), std::runtime_error);
+
+  const auto decoded = decode_stored_options<decltype(options)>(record);
+  ASSERT_EQ(std::get<0>(decoded)->value(), (std::array<double, 2>{3, 4}));
+}
@@ -0,0 +1,250 @@
+#include "OptionalArgument/option_group.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Tolerance          = Named_Type<struct Tolerance_Tag, double>;
+constexpr auto tolerance = typename Tolerance::argument_syntactic_sugar();
+
+using Omega          = Named_Type<struct Omega_Tag, double>;
+constexpr auto omega = typename Omega::argument_syntactic_sugar();
+
+using Weights          = Named_Type<struct Weights_Tag, std::vector<double>>;
+constexpr auto weights = typename Weights::argument_syntactic_sugar();
+
+using Line_Search_Options          = Named_Option_Group<struct Line_Search_Options_Tag>;
+constexpr auto line_search_options = Line_Search_Options();
+
+using Linear_Solver_Options          = Named_Option_Group<struct Linear_Solver_Options_Tag>;
+constexpr auto linear_solver_options = Linear_Solver_Options();
+
+using Preconditioner_Options          = Named_Option_Group<struct Preconditioner_Options_Tag>;
+constexpr auto preconditioner_options = Preconditioner_Options();
+
+// each algorithm returns its resolved options
+
+struct Result
+{
+  size_t line_search_max_iterations;
+  double linear_solver_tolerance;
+  double preconditioner_omega;
+  size_t preconditioner_weights_size;
+  double solver_tolerance;
+};
+
+template <typename... USER_OPTIONS>
+void
+preconditioner(Result& result, const USER_OPTIONS&... user_options)
+{
+  Omega omega{1};
+  Weights weights;
+
+  auto options = take_optional_argument_ref(omega, weights);
+  optional_argument(options, user_options...);
+
+  result.preconditioner_omega        = omega.value();
+  result.preconditioner_weights_size = weights.value().size();
+}
+
+template <typename... USER_OPTIONS>
+void
+line_search(Result& result, const USER_OPTIONS&... user_options)
+{
+  Max_Iterations max_iterations{20};
+
+  auto options = take_optional_argument_ref(max_iterations);
+  optional_argument(options, user_options...);
+
+  result.line_search_max_iterations = max_iterations.value();
+}
+
+template <typename... USER_OPTIONS>
+void
+linear_solver(Result& result, const USER_OPTIONS&... user_options)
+{
+  Tolerance tolerance{1e-10};
+  Preconditioner_Options preconditioner_options;
+
+  auto options = take_optional_argument_ref(tolerance, preconditioner_options);
+  optional_argument(options, user_options...);
+
+  preconditioner(result, project_option_group<Preconditioner_Options>(user_options...));
+
+  result.linear_solver_tolerance = tolerance.value();
+}
+
+template <typename... USER_OPTIONS>
+Result
+solver(USER_OPTIONS&&... user_options)
+{
+  Tolerance tolerance{1e-6};
+  Line_Search_Options line_search_options;
+  Linear_Solver_Options linear_solver_options;
+
+  auto options = take_optional_argument_ref(tolerance, line_search_options, linear_solver_options);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  const auto& line_search_user_options = project_option_group<Line_Search_Options>(user_options...);
+  const auto& linear_solver_user_options =
+      project_option_group<Linear_Solver_Options>(user_options...);
+
+  Result result;
+  for (size_t iteration = 0; iteration < 3; ++iteration)
+  {
+    line_search(result, line_search_user_options);
+    linear_solver(result, linear_solver_user_options);
+  }
+  result.solver_tolerance = tolerance.value();
+
+  return result;
+}
+
+TEST(Option_Group, default)
+{
+  const Result result = solver();
+
+  ASSERT_EQ(result.line_search_max_iterations, 20);
+  ASSERT_EQ(result.linear_solver_tolerance, 1e-10);
+  ASSERT_EQ(result.preconditioner_omega, 1);
+  ASSERT_EQ(result.solver_tolerance, 1e-6);
+}
+
+TEST(Option_Group, nested)
+{
+  // same option type, different levels
+  const Result result =
+      solver(line_search_options(max_iterations = 5), tolerance = 1e-3,
+             linear_solver_options(tolerance = 1e-12,
+                                   preconditioner_options(omega = 1.5, weights = {1, 2, 3})));
+
+  ASSERT_EQ(result.line_search_max_iterations, 5);
+  ASSERT_EQ(result.linear_solver_tolerance, 1e-12);
+  ASSERT_EQ(result.preconditioner_omega, 1.5);
+  ASSERT_EQ(result.preconditioner_weights_size, 3);
+  ASSERT_EQ(result.solver_tolerance, 1e-3);
+}
+
+TEST(Option_Group, projection)
+{
+  static_assert(Is_Option_Group_v<decltype(line_search_options(max_iterations = 5))>);
+  static_assert(Count_Option_Group<Line_Search_Options_Tag,
+                                   Optional_Argument<Tolerance, decltype(line_search_options())>>::
+                    value == 1);
+
+  // lvalue options are stored by reference, the projection refers to
+  // the group content
+  Weights w{std::vector<double>(1000)};
+  const auto group = preconditioner_options(w, omega = 2);
+  static_assert(std::is_same_v<decltype(group),
+                               const Option_Group<Preconditioner_Options_Tag, Weights&, Omega>>);
+
+  const auto& projection = project_option_group<Preconditioner_Options>(tolerance = 1, group);
+  ASSERT_EQ(&projection, &group.options());
+  ASSERT_EQ(&std::get<0>(projection), &w);
+
+  // through a pack
+  const Optional_Argument<Tolerance, decltype(group)> pack(tolerance = 1, group);
+  ASSERT_EQ(&std::get<1>(project_option_group<Preconditioner_Options>(pack)),
+            &std::get<1>(std::get<1>(pack).options()));
+
+  // absent group
+  static_assert(std::is_same_v<decltype(project_option_group<Line_Search_Options>(pack)),
+                               Optional_Argument<>>);
+}
+
+// payload counting its copies and moves
+
+struct Counted
+{
+  static inline size_t copies = 0;
+  static inline size_t moves  = 0;
+
+  Counted() = default;
+  Counted(const Counted&) { ++copies; }
+  Counted(Counted&&) noexcept { ++moves; }
+  Counted&
+  operator=(const Counted&)
+  {
+    ++copies;
+    return *this;
+  }
+  Counted&
+  operator=(Counted&&) noexcept
+  {
+    ++moves;
+    return *this;
+  }
+};
+
+using Payload          = Named_Type<struct Payload_Tag, Counted>;
+constexpr auto payload = typename Payload::argument_syntactic_sugar();
+
+using Inner_Options          = Named_Option_Group<struct Inner_Options_Tag>;
+constexpr auto inner_options = Inner_Options();
+
+template <typename... USER_OPTIONS>
+void
+inner(USER_OPTIONS&&... user_options)
+{
+  Payload payload;
+
+  auto options = take_optional_argument_ref(payload);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+}
+
+template <typename... USER_OPTIONS>
+void
+outer(USER_OPTIONS&&... user_options)
+{
+  Inner_Options inner_options;
+
+  auto options = take_optional_argument_ref(inner_options);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  inner(forward_option_group<Inner_Options>(std::forward<USER_OPTIONS>(user_options)...));
+}
+
+TEST(Option_Group, forward)
+{
+  Counted::copies = 0;
+  inner(payload = Counted());
+  const size_t direct_copies = Counted::copies;
+  ASSERT_EQ(direct_copies, 0);
+
+  // rvalue group: moved into the inner slots
+  Counted::copies = 0;
+  outer(inner_options(payload = Counted()));
+  ASSERT_EQ(Counted::copies, direct_copies);
+
+  // through an rvalue pack
+  Counted::copies = 0;
+  outer(Optional_Argument<decltype(inner_options(payload = Counted()))>(
+      inner_options(payload = Counted())));
+  ASSERT_EQ(Counted::copies, 0);
+
+  // lvalue group: copied, the group is left untouched
+  Counted::copies = 0;
+  const auto group = inner_options(payload = Counted());
+  outer(group);
+  ASSERT_EQ(Counted::copies, 1);
+
+  // lvalue options stored by reference are not moved from
+  Counted::moves = 0;
+  Payload p;
+  outer(inner_options(p));
+  ASSERT_EQ(Counted::moves, 0);
+
+  static_assert(std::is_same_v<decltype(forward_option_group<Inner_Options>(group)),
+                               const Optional_Argument<Payload>&>);
+  static_assert(std::is_same_v<decltype(forward_option_group<Inner_Options>(
+                                   inner_options(payload = Counted()))),
+                               Optional_Argument<Payload>&&>);
+}
@@ -0,0 +1,126 @@
+#include "OptionalArgument/option_hash.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Lower_Bounds          = Named_Type<struct Lower_Bounds_Tag, std::vector<double>>;
+constexpr auto lower_bounds = typename Lower_Bounds::argument_syntactic_sugar();
+
+using Use_Line_Search          = Named_Type<struct Use_Line_Search_Tag>;
+constexpr auto use_line_search = Use_Line_Search();
+
+struct Is_Positive
+{
+  void
+  operator()(const double x) const
+  {
+    assert(x > 0);
+  }
+};
+using Step = Named_Assert_Type<struct Step_Tag, Is_Positive, double>;
+
+// payload without operator==
+struct Point
+{
+  double x, y;
+};
+using Origin = Named_Type<struct Origin_Tag, Point>;
+using Center = Named_Assert_Type<struct Center_Tag, Is_Positive, Point>;
+
+static_assert(Is_Equality_Comparable_v<Max_Iterations>);
+static_assert(Is_Equality_Comparable_v<Use_Line_Search>);
+static_assert(Is_Equality_Comparable_v<Step>);
+static_assert(not Is_Equality_Comparable_v<Origin>);
+static_assert(not Is_Equality_Comparable_v<Center>);
+
+// no hash: disabled std::hash, not an error
+static_assert(std::is_default_constructible_v<std::hash<Max_Iterations>>);
+static_assert(std::is_default_constructible_v<std::hash<Optional_Argument<Max_Iterations&>>>);
+static_assert(not std::is_default_constructible_v<std::hash<Origin>>);
+static_assert(not std::is_invocable_v<std::hash<Origin>, const Origin&>);
+static_assert(not std::is_default_constructible_v<std::hash<Center>>);
+static_assert(
+    not std::is_default_constructible_v<std::hash<Optional_Argument<Max_Iterations, Origin>>>);
+
+TEST(Option_Hash, named_type)
+{
+  ASSERT_EQ(Max_Iterations{3}, max_iterations = 3);
+  ASSERT_NE(Max_Iterations{3}, max_iterations = 4);
+  ASSERT_EQ(Lower_Bounds(std::vector<double>{1, 2}), (lower_bounds = {1, 2}));
+  ASSERT_EQ(Use_Line_Search(), use_line_search);
+  ASSERT_EQ(Step(1.5), Step(1.5));
+
+  std::hash<Max_Iterations> hash;
+  ASSERT_EQ(hash(Max_Iterations{3}), hash(max_iterations = 3));
+  ASSERT_NE(hash(Max_Iterations{3}), hash(max_iterations = 4));
+  ASSERT_EQ(std::hash<Lower_Bounds>()(lower_bounds = {1, 2}),
+            std::hash<Lower_Bounds>()(lower_bounds = {1, 2}));
+  ASSERT_EQ(std::hash<Step>()(Step(2)), std::hash<Step>()(Step(2)));
+
+  std::unordered_set<Lower_Bounds> set{lower_bounds = {1}, lower_bounds = {1, 2}};
+  ASSERT_EQ(set.count(lower_bounds = {1, 2}), 1);
+  ASSERT_EQ(set.count(lower_bounds = {2}), 0);
+}
+
+TEST(Option_Hash, signed_zero)
+{
+  using Tolerance          = Named_Type<struct Tolerance_Tag, double>;
+  constexpr auto tolerance = typename Tolerance::argument_syntactic_sugar();
+
+  // equal values, equal hashes
+  ASSERT_EQ(tolerance = 0.0, tolerance = -0.0);
+  ASSERT_EQ(std::hash<Tolerance>()(tolerance = 0.0), std::hash<Tolerance>()(tolerance = -0.0));
+  ASSERT_EQ((lower_bounds = {1, 0.0}), (lower_bounds = {1, -0.0}));
+  ASSERT_EQ(std::hash<Lower_Bounds>()(lower_bounds = {1, 0.0}),
+            std::hash<Lower_Bounds>()(lower_bounds = {1, -0.0}));
+
+  std::unordered_set<Tolerance> set{tolerance = 0.0};
+  ASSERT_EQ(set.count(tolerance = -0.0), 1);
+}
+
+TEST(Option_Hash, pack)
+{
+  Max_Iterations max_iterations{10};
+  std::optional<Lower_Bounds> lower_bounds;
+  std::optional<Use_Line_Search> use_line_search;
+
+  auto options = take_optional_argument_ref(max_iterations, lower_bounds, use_line_search);
+  Option_Values_t<decltype(options)> values(options);
+  static_assert(std::is_same_v<decltype(values),
+                               Optional_Argument<Max_Iterations, std::optional<Lower_Bounds>,
+                                                 std::optional<Use_Line_Search>>>);
+
+  // references and values: same content, same hash
+  ASSERT_TRUE(values == options);
+  ASSERT_EQ(option_hash(values), option_hash(options));
+
+  // presence matters
+  optional_argument(options, ::use_line_search);
+  ASSERT_FALSE(values == options);
+  ASSERT_NE(option_hash(values), option_hash(options));
+
+  optional_argument(options, ::lower_bounds = {});
+  values = options;
+  ASSERT_TRUE(values == options);
+  ASSERT_EQ(option_hash(values), option_hash(options));
+
+  lower_bounds->value().push_back(1);
+  ASSERT_FALSE(values == options);
+  ASSERT_NE(option_hash(values), option_hash(options));
+
+  // key of an unordered_map
+  std::unordered_map<decltype(values), int> map;
+  map[values] = 1;
+  values      = options;
+  map[values] = 2;
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map.at(values), 2);
+}
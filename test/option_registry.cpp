@@ -0,0 +1,170 @@
+#include "OptionalArgument/option_registry.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Absolute_Precision          = Named_Type<struct Absolute_Precision_Tag, double>;
+constexpr auto absolute_precision = typename Absolute_Precision::argument_syntactic_sugar();
+
+using Starting_Point          = Named_Type<struct Starting_Point_Tag, std::vector<double>>;
+constexpr auto starting_point = typename Starting_Point::argument_syntactic_sugar();
+
+template <typename... USER_OPTIONS>
+double
+my_algorithm(USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{10};
+  Absolute_Precision absolute_precision{1};
+  std::optional<Starting_Point> starting_point;
+
+  auto options = take_optional_argument_ref(max_iterations, absolute_precision, starting_point);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  return max_iterations.value() * absolute_precision.value() +
+         (starting_point ? starting_point->value().size() : 0);
+}
+
+TEST(Option_Registry, nested_optional_argument)
+{
+  Optional_Argument<std::optional<Max_Iterations>, std::optional<Absolute_Precision>> stored;
+
+  ASSERT_EQ(my_algorithm(stored), 10);
+  std::get<0>(stored) = max_iterations = 20;
+  ASSERT_EQ(my_algorithm(stored), 20);
+  ASSERT_EQ(my_algorithm(stored, absolute_precision = 2), 40);
+  ASSERT_EQ(my_algorithm(absolute_precision = 2, stored, max_iterations = 3), 6);
+
+  Optional_Argument<Starting_Point> moved{starting_point = std::vector<double>(5)};
+  ASSERT_EQ(my_algorithm(std::move(moved)), 15);
+  ASSERT_TRUE(std::get<0>(moved).value().empty());
+}
+
+TEST(Option_Registry, update)
+{
+  Option_Registry<Max_Iterations, Absolute_Precision, Starting_Point> registry(
+      absolute_precision = 0.5);
+
+  ASSERT_EQ(registry.version(), 0);
+  ASSERT_EQ(my_algorithm(*registry.snapshot()), 5);
+
+  {
+    auto snapshot = registry.snapshot();
+
+    registry.update(max_iterations = 100);
+    ASSERT_EQ(registry.version(), 1);
+
+    // an already taken snapshot is immutable
+    ASSERT_EQ(my_algorithm(*snapshot), 5);
+  }
+  ASSERT_EQ(my_algorithm(*registry.snapshot()), 50);
+  ASSERT_EQ(my_algorithm(*registry.snapshot(), max_iterations = 4), 2);
+
+  registry.publish({});
+  ASSERT_EQ(my_algorithm(*registry.snapshot()), 10);
+
+  ASSERT_EQ(Epoch_Domain::instance().reclaim(), 0);
+}
+
+TEST(Option_Registry, concurrent_readers)
+{
+  Option_Registry<Max_Iterations, Absolute_Precision, Starting_Point> registry(
+      max_iterations = 1, starting_point = std::vector<double>(1));
+
+  std::atomic<bool> stop{false};
+  std::atomic<size_t> errors{0};
+
+  auto reader = [&]() {
+    while (not stop.load())
+    {
+      auto snapshot = registry.snapshot();
+
+      // writer invariant: max_iterations == starting_point size
+      const auto& stored_max_iterations = std::get<std::optional<Max_Iterations>>(*snapshot);
+      const auto& stored_starting_point = std::get<std::optional<Starting_Point>>(*snapshot);
+      if (stored_max_iterations->value() != stored_starting_point->value().size()) ++errors;
+
+      my_algorithm(*snapshot);
+    }
+  };
+
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < 4; ++i) readers.emplace_back(reader);
+
+  for (size_t i = 2; i < 2000; ++i)
+  {
+    registry.update(max_iterations = i, starting_point = std::vector<double>(i));
+  }
+
+  stop = true;
+  for (auto& thread : readers) thread.join();
+
+  ASSERT_EQ(errors, 0);
+  ASSERT_EQ(registry.version(), 1998);
+  ASSERT_EQ(Epoch_Domain::instance().reclaim(), 0);
+}
+
+TEST(Option_Registry, reader_slots_exhausted)
+{
+  Epoch_Domain& domain = Epoch_Domain::instance();
+
+  // holders take the free reader slots until one fails
+  std::atomic<bool> release{false};
+  std::vector<std::thread> holders;
+  for (bool acquired = true; acquired;)
+  {
+    std::promise<bool> promise;
+    std::future<bool> future = promise.get_future();
+    holders.emplace_back([&, promise = std::move(promise)]() mutable {
+      try
+      {
+        domain.enter();
+        domain.leave();
+      }
+      catch (const std::length_error&)
+      {
+        promise.set_value(false);
+        return;
+      }
+      promise.set_value(true);
+      while (not release.load()) std::this_thread::yield();
+    });
+    acquired = future.get();
+  }
+  ASSERT_LE(holders.size(), max_thread_indices + 1);
+
+  std::atomic<int> step{0};
+  std::thread reader([&]() {
+    EXPECT_THROW(domain.enter(), std::length_error);
+    step = 1;
+    while (step.load() != 2) std::this_thread::yield();
+
+    // slots available again: the read is protected
+    domain.enter();
+    step = 3;
+    while (step.load() != 4) std::this_thread::yield();
+    domain.leave();
+  });
+
+  while (step.load() != 1) std::this_thread::yield();
+  release = true;
+  for (auto& thread : holders) thread.join();
+  step = 2;
+  while (step.load() != 3) std::this_thread::yield();
+
+  domain.retire(new int(0));
+  EXPECT_EQ(domain.reclaim(), 1);  // the reader may still use it
+
+  step = 4;
+  reader.join();
+  ASSERT_EQ(domain.reclaim(), 0);
+}
@@ -0,0 +1,89 @@
+#include "OptionalArgument/option_result_cache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Use_Line_Search          = Named_Type<struct Use_Line_Search_Tag>;
+constexpr auto use_line_search = Use_Line_Search();
+
+std::atomic<size_t> computations{0};
+
+struct My_Algorithm_Tag;
+
+template <typename... USER_OPTIONS>
+double
+my_algorithm(const std::vector<double>& x, USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{10};
+  std::optional<Use_Line_Search> use_line_search;
+
+  auto options = take_optional_argument_ref(max_iterations, use_line_search);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  auto& cache = option_result_cache<My_Algorithm_Tag, decltype(options), double>(4);
+
+  return cache.find_or_compute(input_digest(x), options, [&]() {
+    ++computations;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));  // expensive
+
+    double sum = use_line_search.has_value();
+    for (auto x_i : x) sum += x_i * max_iterations.value();
+    return sum;
+  });
+}
+
+TEST(Option_Result_Cache, memoize)
+{
+  const std::vector<double> x{1, 2, 3};
+
+  computations = 0;
+  ASSERT_EQ(my_algorithm(x), 60);
+  ASSERT_EQ(my_algorithm(x), 60);
+  ASSERT_EQ(my_algorithm(x, max_iterations = 10), 60);
+  ASSERT_EQ(computations, 1);
+
+  // other inputs, options or option presence
+  ASSERT_EQ(my_algorithm(std::vector<double>{1, 2}), 30);
+  ASSERT_EQ(my_algorithm(x, max_iterations = 1), 6);
+  ASSERT_EQ(my_algorithm(x, use_line_search), 61);
+  ASSERT_EQ(computations, 4);
+
+  // cached call
+  ASSERT_EQ(my_algorithm(x, use_line_search), 61);
+  ASSERT_EQ(computations, 4);
+}
+
+TEST(Option_Result_Cache, bounded_and_thread_safe)
+{
+  using Options = Optional_Argument<Max_Iterations&>;
+  Option_Result_Cache<Options, size_t> cache(8);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&cache]() {
+      for (size_t i = 0; i < 1000; ++i)
+      {
+        Max_Iterations max_iterations{i % 16};
+        const Options options(max_iterations);
+
+        const size_t result =
+            cache.find_or_compute(input_digest(i % 2), options, [i]() { return i % 16; });
+        ASSERT_EQ(result, i % 16);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  ASSERT_EQ(cache.size(), 8);
+  ASSERT_EQ(cache.statistics().calls(), 4000);
+}
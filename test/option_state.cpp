@@ -0,0 +1,169 @@
+#include "OptionalArgument/option_state.hpp"
+#include "OptionalArgument/named_std_function.hpp"
+
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+using Regularization          = Named_Type<struct Regularization_Tag, double>;
+constexpr auto regularization = typename Regularization::argument_syntactic_sugar();
+
+using Lower_Bounds          = Named_Type<struct Lower_Bounds_Tag, std::vector<double>>;
+constexpr auto lower_bounds = typename Lower_Bounds::argument_syntactic_sugar();
+
+using Use_Line_Search          = Named_Type<struct Use_Line_Search_Tag>;
+constexpr auto use_line_search = Use_Line_Search();
+
+using Callback          = Named_Std_Function<struct Callback_Tag, void, size_t>;
+constexpr auto callback = Argument_Syntactic_Sugar<Callback>();
+
+// expensive setups: factorization (depends on regularization), bound
+// preprocessing (depends on lower_bounds)
+class Solver
+{
+  Option_State<Max_Iterations, Regularization, std::optional<Lower_Bounds>,
+               std::optional<Use_Line_Search>>
+      _state{Max_Iterations{100}, Regularization{0}, std::nullopt, std::nullopt};
+
+ public:
+  size_t factorizations = 0, bound_preprocessings = 0;
+
+  template <typename... USER_OPTIONS>
+  size_t
+  solve(USER_OPTIONS&&... user_options)
+  {
+    optional_argument(_state, std::forward<USER_OPTIONS>(user_options)...);
+
+    if (_state.is_dirty<Regularization>()) ++factorizations;
+    if (_state.is_dirty<Lower_Bounds>()) ++bound_preprocessings;
+    _state.clear_dirty();
+
+    return _state.get<Max_Iterations>().value();
+  }
+
+  void
+  invalidate_factorization()
+  {
+    _state.mark_dirty<Regularization>();
+  }
+};
+
+TEST(Option_State, warm_restart)
+{
+  Solver solver;
+
+  // first call: full setup
+  ASSERT_EQ(solver.solve(), 100);
+  ASSERT_EQ(solver.factorizations, 1);
+  ASSERT_EQ(solver.bound_preprocessings, 1);
+
+  // same options, no setup
+  ASSERT_EQ(solver.solve(max_iterations = 10), 10);
+  ASSERT_EQ(solver.solve(max_iterations = 10, use_line_search), 10);
+  ASSERT_EQ(solver.factorizations, 1);
+  ASSERT_EQ(solver.bound_preprocessings, 1);
+
+  // a value change
+  solver.solve(regularization = 1e-3);
+  solver.solve(regularization = 1e-3, lower_bounds = {0, 0});
+  ASSERT_EQ(solver.factorizations, 2);
+  ASSERT_EQ(solver.bound_preprocessings, 2);
+
+  solver.solve(regularization = 1e-3, lower_bounds = {0, 0});
+  ASSERT_EQ(solver.factorizations, 2);
+  ASSERT_EQ(solver.bound_preprocessings, 2);
+
+  // omitted options get back their default values
+  solver.solve();
+  ASSERT_EQ(solver.factorizations, 3);
+  ASSERT_EQ(solver.bound_preprocessings, 3);
+  solver.solve();
+  ASSERT_EQ(solver.factorizations, 3);
+
+  // explicit marking
+  solver.invalidate_factorization();
+  solver.solve();
+  ASSERT_EQ(solver.factorizations, 4);
+  ASSERT_EQ(solver.bound_preprocessings, 3);
+}
+
+TEST(Option_State, dirty_mask)
+{
+  Option_State<Max_Iterations, std::optional<Lower_Bounds>, std::optional<Callback>> state;
+  ASSERT_TRUE(state.is_dirty());
+  ASSERT_EQ(state.dirty_mask().count(), 3);
+  state.clear_dirty();
+  ASSERT_FALSE(state.is_dirty());
+
+  ASSERT_EQ(state.update(lower_bounds = {1}).to_string(), "010");
+  ASSERT_EQ(state.find<Lower_Bounds>()->value(), std::vector<double>{1});
+  ASSERT_TRUE((state.is_dirty<Max_Iterations, Lower_Bounds>()));
+  ASSERT_FALSE(state.is_dirty<Max_Iterations>());
+
+  // without operator==: dirty when given, or when back to default
+  state.clear_dirty();
+  state.update(lower_bounds = {1}, callback = [](size_t) {});
+  ASSERT_EQ(state.dirty_mask().to_string(), "100");
+  state.clear_dirty();
+  state.update(lower_bounds = {1});
+  ASSERT_EQ(state.dirty_mask().to_string(), "100");
+  ASSERT_EQ(state.find<Callback>(), nullptr);
+  state.clear_dirty();
+  state.update(lower_bounds = {1});
+  ASSERT_FALSE(state.is_dirty());
+
+  // dirty bits accumulate until cleared
+  state.update(max_iterations = 5, lower_bounds = {1});
+  state.update(max_iterations = 5);
+  ASSERT_EQ(state.dirty_mask().to_string(), "011");
+  state.clear_dirty<Lower_Bounds>();
+  ASSERT_EQ(state.dirty_mask().to_string(), "001");
+}
+
+// payload without operator==
+struct Point
+{
+  double x, y;
+};
+using Origin          = Named_Type<struct Origin_Tag, Point>;
+constexpr auto origin = typename Origin::argument_syntactic_sugar();
+
+using Target          = Named_Type<struct Target_Tag, Point>;
+constexpr auto target = typename Target::argument_syntactic_sugar();
+
+TEST(Option_State, payload_without_equality)
+{
+  Option_State<Origin, std::optional<Target>> state{Origin{Point{0, 0}}, std::nullopt};
+  state.clear_dirty();
+
+  // dirty when given, or when back to default
+  ASSERT_EQ(state.update(origin = Point{1, 2}).to_string(), "01");
+  ASSERT_EQ(state.get<Origin>().value().y, 2);
+  state.clear_dirty();
+  ASSERT_EQ(state.update(origin = Point{1, 2}, target = Point{3, 4}).to_string(), "11");
+  ASSERT_EQ(state.find<Target>()->value().x, 3);
+  state.clear_dirty();
+  ASSERT_EQ(state.update().to_string(), "11");
+  ASSERT_EQ(state.get<Origin>().value().y, 0);
+  ASSERT_EQ(state.find<Target>(), nullptr);
+  state.clear_dirty();
+  ASSERT_FALSE(state.update().any());
+}
+
+TEST(Option_State, packs)
+{
+  Option_State<Max_Iterations, Regularization> state{Max_Iterations{100}, Regularization{0}};
+  state.clear_dirty();
+
+  const Optional_Argument<std::optional<Regularization>> stored{regularization = 2.};
+  state.update(stored);
+  ASSERT_EQ(state.get<Regularization>().value(), 2);
+  ASSERT_TRUE(state.is_dirty<Regularization>());
+  ASSERT_FALSE(state.is_dirty<Max_Iterations>());
+}
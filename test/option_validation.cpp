@@ -0,0 +1,143 @@
+#include "OptionalArgument/option_validation.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <valarray>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+template <typename T>
+using Lower_Bounds = Named_Assert_Type<struct Lower_Bounds_Tag, Assert_No_NaN<>, std::vector<T>>;
+template <typename T>
+constexpr auto lower_bounds = typename Lower_Bounds<T>::argument_syntactic_sugar();
+
+template <typename T>
+using Upper_Bounds = Named_Assert_Type<struct Upper_Bounds_Tag, Assert_No_NaN<>, std::vector<T>>;
+template <typename T>
+constexpr auto upper_bounds = typename Upper_Bounds<T>::argument_syntactic_sugar();
+
+using Weights = Named_Assert_Type<struct Weights_Tag, Assert_Finite<>, std::valarray<double>>;
+constexpr auto weights = typename Weights::argument_syntactic_sugar();
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+TEST(Option_Validation, all_of_vectorized)
+{
+  std::vector<double> v(1000, 1);
+
+  ASSERT_TRUE(all_of_vectorized(v.data(), v.size(), Is_Not_NaN()));
+  v[999] = std::numeric_limits<double>::quiet_NaN();
+  ASSERT_FALSE(all_of_vectorized(v.data(), v.size(), Is_Not_NaN()));
+  ASSERT_TRUE(all_of_vectorized(v.data(), 999, Is_Not_NaN()));
+  ASSERT_TRUE(all_of_vectorized(v.data(), 0, Is_Not_NaN()));
+
+  v[999] = std::numeric_limits<double>::infinity();
+  ASSERT_TRUE(all_of_vectorized(v.data(), v.size(), Is_Not_NaN()));
+  ASSERT_FALSE(all_of_vectorized(v.data(), v.size(), Is_Finite()));
+}
+
+TEST(Option_Validation, Assert_Elementwise)
+{
+  ASSERT_NO_THROW(lower_bounds<double> = std::vector<double>(10, 0));
+  ASSERT_THROW(lower_bounds<double> = std::vector<double>(10, std::nan("")), std::domain_error);
+
+  std::valarray<double> w(1., 10);
+  ASSERT_NO_THROW(weights = w);
+  w[3] = std::numeric_limits<double>::infinity();
+  ASSERT_THROW(weights = w, std::domain_error);
+}
+
+template <typename T, typename... USER_OPTIONS>
+size_t
+my_algorithm(const std::vector<T>&, USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{10};
+  std::optional<Lower_Bounds<T>> lower_bounds;
+  std::optional<Upper_Bounds<T>> upper_bounds;
+
+  auto options = take_optional_argument_ref(max_iterations, lower_bounds, upper_bounds);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  check_option_constraints(
+      options,
+      option_constraint<Lower_Bounds<T>, Upper_Bounds<T>>(Same_Size(), "bound sizes differ"),
+      option_constraint<Lower_Bounds<T>, Upper_Bounds<T>>(Elementwise_Less_Equal(),
+                                                          "lower_bounds <= upper_bounds"));
+
+  return max_iterations.value();
+}
+
+TEST(Option_Validation, find_option)
+{
+  Max_Iterations max_iterations{10};
+  std::optional<Lower_Bounds<double>> lower_bounds;
+
+  auto options = take_optional_argument_ref(max_iterations, lower_bounds);
+
+  ASSERT_EQ(find_option<Max_Iterations>(options), &max_iterations);
+  ASSERT_EQ(find_option<Lower_Bounds<double>>(options), nullptr);
+  lower_bounds.emplace(std::vector<double>(2, 0));
+  ASSERT_EQ(find_option<Lower_Bounds<double>>(options), &*lower_bounds);
+}
+
+TEST(Option_Validation, check_option_constraints)
+{
+  const size_t n = 1000;
+  std::vector<double> x(n);
+
+  ASSERT_EQ(my_algorithm(x), 10);
+  ASSERT_EQ(my_algorithm(x, upper_bounds<double> = std::vector<double>(n, -1)), 10);
+  ASSERT_EQ(my_algorithm(x, lower_bounds<double> = std::vector<double>(n, 0),
+                         upper_bounds<double> = std::vector<double>(n, 1)),
+            10);
+
+  ASSERT_THROW(my_algorithm(x, lower_bounds<double> = std::vector<double>(n, 0),
+                            upper_bounds<double> = std::vector<double>(n, -1)),
+               std::domain_error);
+  ASSERT_THROW(my_algorithm(x, lower_bounds<double> = std::vector<double>(n, 0),
+                            upper_bounds<double> = std::vector<double>(n - 1, 1)),
+               std::domain_error);
+
+  // scalar broadcast
+  ASSERT_TRUE(Elementwise_Less_Equal()(0., std::vector<double>(n, 1)));
+  ASSERT_FALSE(Elementwise_Less_Equal()(std::vector<double>(n, 1), 0.));
+
+  // a 1-element vector is not broadcasted
+  ASSERT_FALSE(Elementwise_Less_Equal()(std::vector<double>{0}, std::vector<double>(n, 1)));
+  ASSERT_FALSE(Elementwise_Less_Equal()(std::vector<double>(n, 0), std::array<double, 1>{1}));
+  ASSERT_THROW(my_algorithm(x, lower_bounds<double> = std::vector<double>{0},
+                            upper_bounds<double> = std::vector<double>(n, 1)),
+               std::domain_error);
+}
+
+//////////////// Assert_Predicate ////////////////
+//
+using Absolute_Precision =
+    Named_Assert_Type<struct Absolute_Precision_Tag, Assert_Predicate<Is_Positive>, double>;
+constexpr auto absolute_precision = typename Absolute_Precision::argument_syntactic_sugar();
+
+using Trapped_Precision =
+    Named_Assert_Type<struct Trapped_Precision_Tag,
+                      Assert_Predicate<Is_Positive, Trap_On_Failure>, double>;
+constexpr auto trapped_precision = typename Trapped_Precision::argument_syntactic_sugar();
+
+TEST(Option_Validation, Assert_Predicate)
+{
+  // checked at compile time, (absolute_precision = -1e-6) does not compile
+  constexpr Absolute_Precision eps = (absolute_precision = 1e-6);
+  static_assert(eps.value() == 1e-6);
+
+  // run-time values
+  const double positive = 1e-6, negative = -1e-6;
+
+  ASSERT_EQ((absolute_precision = positive).value(), 1e-6);
+  ASSERT_THROW(absolute_precision = negative, std::domain_error);
+
+  ASSERT_EQ((trapped_precision = positive).value(), 1e-6);
+  ASSERT_DEATH(trapped_precision = negative, "");
+}
@@ -199,6 +199,60 @@ TEST(Optional_Argument, foo_flag)
   ASSERT_EQ(b_2, true);
 }
 
+//////////////// traced_optional_argument ////////////////
+//
+
+TEST(Optional_Argument, Type_Index)
+{
+  ASSERT_EQ((Type_Index_v<int, double, int&, int>), 2);
+  ASSERT_EQ((Type_Index_v<int, double>), 1);
+}
+
+template <typename TRACER, typename... OPTIONS>
+std::vector<int>
+foo_traced(TRACER&& tracer, OPTIONS&&... options)
+{
+  Flag flag{false};
+  std::optional<Starting_Point_Vector<int>> v;
+
+  auto opt_arg = take_optional_argument_ref(flag, v);
+  traced_optional_argument(tracer, opt_arg, std::forward<OPTIONS>(options)...);
+
+  return v.has_value() ? v->value() : std::vector<int>();
+}
+
+TEST(Optional_Argument, traced_optional_argument)
+{
+  std::vector<Option_Trace> traces;
+  auto tracer = [&traces](const Option_Trace& trace) { traces.push_back(trace); };
+
+  const Flag flag_on{true};
+  std::vector<int> y(3, 1);
+
+  ASSERT_EQ(foo_traced(tracer, starting_point_vector<int> = std::move(y), flag_on).size(), 3);
+  ASSERT_EQ(traces.size(), 2);
+
+  ASSERT_EQ(traces[0].option_name, "Starting_Point_Vector_Tag");
+  ASSERT_EQ(traces[0].slot_index, 1);
+  ASSERT_EQ(traces[0].wrapper_transfer, Option_Transfer::Move);
+  ASSERT_EQ(traces[0].wrapper_size, sizeof(std::vector<int>));
+
+  ASSERT_EQ(traces[1].slot_index, 0);
+  ASSERT_EQ(traces[1].wrapper_transfer, Option_Transfer::Copy);
+  ASSERT_EQ(traces[1].wrapper_size, sizeof(bool));
+
+  // the payload copy made by the syntactic sugar is not seen: the
+  // wrapper holding the copy is moved
+  const std::vector<int> z(3, 1);
+  traces.clear();
+  foo_traced(tracer, starting_point_vector<int> = z);
+  ASSERT_EQ(traces[0].wrapper_transfer, Option_Transfer::Move);
+
+  // No tracer: nothing to store, nothing to call
+  ASSERT_TRUE(std::is_empty_v<No_Option_Tracer>);
+  ASSERT_EQ(foo_traced(No_Option_Tracer(), flag_on).size(), 0);
+}
+
 //////////////// Named_Assert ////////////////
 //
 template <typename T>
@@ -295,6 +349,20 @@ TEST(Optional_Argument, Named_Std_Function)
   ASSERT_EQ(my_algorithm(objective_function = f, x), 804);
 }
 
+TEST(Optional_Argument, Copy_Named_Std_Function)
+{
+  std::vector<double> x(2, -1);
+
+  const Objective_Function f = (objective_function = Rosenbrock);
+
+  // a const rvalue must be copied, not wrapped
+  Objective_Function g(std::move(f));
+  ASSERT_EQ(my_algorithm(g, x), 44);
+
+  auto capture = [f]() { return f; };
+  ASSERT_EQ(my_algorithm(std::move(capture)(), x), 44);
+}
+
 TEST(Optional_Argument, Lambda_to_Named_Std_Function)
 {
   using Adam_Alpha_Schedule =
@@ -0,0 +1,107 @@
+#include "OptionalArgument/static_dispatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+enum class Norm
+{
+  L1,
+  L2,
+  Linf,
+  L3  // not dispatched
+};
+
+using Norm_Option = Named_Type<struct Norm_Tag, Norm>;
+constexpr auto norm = typename Norm_Option::argument_syntactic_sugar();
+
+using Use_Weights          = Named_Type<struct Use_Weights_Tag>;
+constexpr auto use_weights = Use_Weights();
+
+using Use_Scaling          = Named_Type<struct Use_Scaling_Tag, bool>;
+constexpr auto use_scaling = typename Use_Scaling::argument_syntactic_sugar();
+
+using Norm_Kernels = Static_Dispatch<Flag_Dispatch<Use_Weights>, Flag_Dispatch<Use_Scaling>,
+                                     Enum_Dispatch<Norm_Option, Norm::L1, Norm::L2, Norm::Linf>>;
+
+// weighted norm, instantiated for each option combination
+template <typename... USER_OPTIONS>
+double
+weighted_norm(const std::vector<double>& x, const std::vector<double>& w,
+              USER_OPTIONS&&... user_options)
+{
+  std::optional<Use_Weights> use_weights;
+  Use_Scaling use_scaling{false};
+  Norm_Option norm{Norm::L2};
+
+  auto options = take_optional_argument_ref(use_weights, use_scaling, norm);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  return Norm_Kernels::dispatch(options, [&](auto weighted, auto scaled, auto p) {
+    static_assert(std::is_same_v<typename decltype(p)::value_type, Norm>);
+
+    double result = 0;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+      double x_i = x[i];
+      if constexpr (weighted) x_i *= w[i];
+      if constexpr (scaled) x_i /= static_cast<double>(x.size());
+
+      if constexpr (p == Norm::L1) result += std::abs(x_i);
+      if constexpr (p == Norm::L2) result += x_i * x_i;
+      if constexpr (p == Norm::Linf) result = std::max(result, std::abs(x_i));
+    }
+    return (p == Norm::L2) ? std::sqrt(result) : result;
+  });
+}
+
+TEST(Static_Dispatch, table)
+{
+  static_assert(Norm_Kernels::size == 12);
+
+  std::optional<Use_Weights> weights;
+  Use_Scaling scaling{true};
+  Norm_Option p{Norm::Linf};
+
+  ASSERT_EQ(Norm_Kernels::index(take_optional_argument_ref(weights, scaling, p)), 5);
+  ASSERT_EQ(Norm_Kernels::index(Optional_Argument<Use_Weights, Use_Scaling, Norm_Option>(
+                use_weights, use_scaling = false, norm = Norm::L1)),
+            6);
+
+  // a missing enum option
+  std::optional<Norm_Option> no_p;
+  ASSERT_THROW(Norm_Kernels::index(take_optional_argument_ref(weights, scaling, no_p)),
+               std::domain_error);
+}
+
+TEST(Static_Dispatch, kernel)
+{
+  const std::vector<double> x{3, -4}, w{2, 1};
+
+  ASSERT_EQ(weighted_norm(x, w), 5);
+  ASSERT_EQ(weighted_norm(x, w, norm = Norm::L1), 7);
+  ASSERT_EQ(weighted_norm(x, w, norm = Norm::Linf, use_weights), 6);
+  ASSERT_EQ(weighted_norm(x, w, norm = Norm::L1, use_weights, use_scaling = true), 5);
+  ASSERT_EQ(weighted_norm(x, w, use_scaling = true), 2.5);
+
+  // not in the declared subset
+  ASSERT_THROW(weighted_norm(x, w, norm = Norm::L3), std::domain_error);
+}
+
+TEST(Static_Dispatch, free_function)
+{
+  std::optional<Use_Weights> weights;
+  auto options = take_optional_argument_ref(weights);
+
+  auto kernel = [](auto weighted) -> int { return weighted ? 1 : 0; };
+  ASSERT_EQ(static_dispatch<Flag_Dispatch<Use_Weights>>(options, kernel), 0);
+
+  optional_argument(options, use_weights);
+  ASSERT_EQ(static_dispatch<Flag_Dispatch<Use_Weights>>(options, kernel), 1);
+}
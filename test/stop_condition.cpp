@@ -0,0 +1,99 @@
+#include "OptionalArgument/stop_condition.hpp"
+
+#include <chrono>
+#include <thread>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Deadline          = Named_Deadline<struct Deadline_Tag>;
+constexpr auto deadline = typename Deadline::argument_syntactic_sugar();
+
+using Coarse_Deadline          = Named_Deadline<struct Coarse_Deadline_Tag, Coarse_Steady_Clock>;
+constexpr auto coarse_deadline = typename Coarse_Deadline::argument_syntactic_sugar();
+
+using Cancellation          = Named_Cancellation<struct Cancellation_Tag>;
+constexpr auto cancellation = typename Cancellation::argument_syntactic_sugar();
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+// returns the number of iterations
+template <typename... USER_OPTIONS>
+size_t
+solver(USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{1000};
+  Deadline deadline;
+  Coarse_Deadline coarse_deadline;
+  Cancellation cancellation;
+
+  auto options =
+      take_optional_argument_ref(max_iterations, deadline, coarse_deadline, cancellation);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  size_t iteration = 0;
+  for (; iteration < max_iterations.value(); ++iteration)
+  {
+    if (should_stop(deadline, coarse_deadline, cancellation)) break;
+  }
+  return iteration;
+}
+
+TEST(Stop_Condition, deadline)
+{
+  ASSERT_EQ(solver(), 1000);
+
+  // expired: detected at the first poll
+  ASSERT_EQ(solver(deadline = std::chrono::steady_clock::now()),
+            Deadline::default_poll_period - 1);
+  ASSERT_EQ(solver((deadline = std::chrono::steady_clock::now()).with_poll_period(1)), 0);
+  ASSERT_EQ(solver(deadline = std::chrono::hours(1)), 1000);
+
+  Deadline d = (deadline = std::chrono::milliseconds(20));
+  ASSERT_TRUE(d.has_deadline());
+  ASSERT_FALSE(d.is_expired());
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  ASSERT_TRUE(d.is_expired());
+
+  size_t calls = 1;
+  while (not d.should_stop()) ++calls;
+  ASSERT_EQ(calls, Deadline::default_poll_period);
+}
+
+TEST(Stop_Condition, coarse_clock)
+{
+  const auto start = Coarse_Steady_Clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_GT(Coarse_Steady_Clock::now(), start);
+  ASSERT_LE(Coarse_Steady_Clock::now(), std::chrono::steady_clock::now());
+
+  ASSERT_EQ(solver((coarse_deadline = std::chrono::milliseconds(0)).with_poll_period(1)), 0);
+
+  // the first now() starts a thread: can throw
+  static_assert(not noexcept(Coarse_Steady_Clock::now()));
+  static_assert(not noexcept(std::declval<Coarse_Deadline&>().should_stop()));
+  static_assert(noexcept(std::declval<Deadline&>().should_stop()));
+  static_assert(noexcept(should_stop(std::declval<Deadline&>(), std::declval<Cancellation&>())));
+}
+
+TEST(Stop_Condition, cancellation)
+{
+  Cancellation_Flag flag;
+  ASSERT_EQ(solver(cancellation = flag), 1000);
+
+  flag.cancel();
+  ASSERT_EQ(solver(cancellation = flag), 0);
+  flag.reset();
+
+  // from another thread
+  std::thread canceller([&flag]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    flag.cancel();
+  });
+  const size_t n = solver(cancellation = flag, max_iterations = size_t(-1));
+  canceller.join();
+  ASSERT_LT(n, size_t(-1));
+}
@@ -0,0 +1,88 @@
+#include "OptionalArgument/workspace.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace OptionalArgument;
+
+using Solver_Workspace          = Named_Workspace<struct Solver_Workspace_Tag, double>;
+constexpr auto solver_workspace = typename Solver_Workspace::argument_syntactic_sugar();
+
+using Max_Iterations          = Named_Type<struct Max_Iterations_Tag, size_t>;
+constexpr auto max_iterations = typename Max_Iterations::argument_syntactic_sugar();
+
+// returns the scratch address, to check reuse
+template <typename... USER_OPTIONS>
+const double*
+solver(const std::vector<double>& x, USER_OPTIONS&&... user_options)
+{
+  Max_Iterations max_iterations{10};
+  Solver_Workspace workspace;
+
+  auto options = take_optional_argument_ref(max_iterations, workspace);
+  optional_argument(options, std::forward<USER_OPTIONS>(user_options)...);
+
+  const size_t n              = x.size();
+  auto [gradient, x_previous] = workspace.value().acquire(n, n);
+  EXPECT_EQ(gradient.size(), n);
+  EXPECT_EQ(x_previous.data(), gradient.data() + n);
+
+  for (size_t i = 0; i < n; ++i) gradient[i] = x[i];
+
+  return gradient.data();
+}
+
+TEST(Workspace, capacity)
+{
+  Workspace<double> workspace;
+  ASSERT_EQ(workspace.capacity(), 0);
+  ASSERT_EQ(workspace.grow_count(), 0);
+
+  ASSERT_EQ(Workspace<double>::required_size(3, 4, 5), 12);
+
+  auto [a, b, c] = workspace.acquire(3, 4, 5);
+  ASSERT_EQ(workspace.capacity(), 12);
+  ASSERT_EQ(c.data() + c.size(), a.data() + 12);
+  ASSERT_EQ(b.size(), 4);
+
+  // grows only when needed
+  ASSERT_FALSE(workspace.reserve(10));
+  workspace.acquire(6);
+  ASSERT_EQ(workspace.grow_count(), 1);
+  ASSERT_TRUE(workspace.reserve(20));
+  ASSERT_EQ(workspace.grow_count(), 2);
+  ASSERT_EQ(workspace.capacity(), 20);
+}
+
+TEST(Workspace, option)
+{
+  const std::vector<double> x(100, 1);
+
+  // caller supplied: allocated once
+  Workspace<double> workspace;
+  const double* scratch = solver(x, solver_workspace = workspace);
+  for (size_t i = 0; i < 5; ++i)
+  {
+    ASSERT_EQ(solver(x, max_iterations = i, solver_workspace = workspace), scratch);
+  }
+  ASSERT_EQ(workspace.grow_count(), 1);
+  ASSERT_EQ(workspace.capacity(), 200);
+
+  // pre-sized
+  Workspace<double> presized(Workspace<double>::required_size(x.size(), x.size()));
+  solver(x, solver_workspace = presized);
+  ASSERT_EQ(presized.grow_count(), 1);
+
+  // omitted: internal temporary
+  Solver_Workspace omitted;
+  ASSERT_FALSE(omitted.is_caller_supplied());
+  ASSERT_NE(solver(x), scratch);
+  ASSERT_EQ(workspace.grow_count(), 1);
+
+  // a copy shares the caller workspace, not the fallback
+  const Solver_Workspace supplied = (solver_workspace = workspace);
+  const Solver_Workspace copy(supplied);
+  ASSERT_TRUE(copy.is_caller_supplied());
+  ASSERT_EQ(&copy.value(), &workspace);
+}